@@ -159,10 +159,10 @@ void FDTrackFlystickInputDevice::SendControllerEvents()
 			IPlatformInputDeviceMapper::Get().RemapControllerIdToPlatformUserAndDevice( flystick_static_data->m_flystick_id, UserId, DeviceId );
 #endif
 			//Process buttons
-			for (int32 i = 0; i < flystick_frame_data->m_button_state.Num(); ++i) 
+			for (int32 i = 0; i < flystick_static_data->m_button_count; ++i) 
 			{
 
-				const bool current_button_state = flystick_frame_data->m_button_state[i];
+				const bool current_button_state = ((flystick_frame_data->m_button_mask >> i) & 1) != 0;
 				if ( current_button_state != flystick_state.m_buttons_state[i] ) 
 				{
 					//UE_LOG( LogDTrackInput, Warning, TEXT( "flystick name %s id %d button %d state %d"), 
@@ -206,11 +206,11 @@ void FDTrackFlystickInputDevice::SendControllerEvents()
 
 			bool flystick_changed = false;
 
-			for (int32 i = 0; i < flystick_frame_data->m_joystick_state.Num(); ++i) 
+			for (int32 i = 0; i < flystick_static_data->m_joystick_count; ++i) 
 			{			
 				if (i >= 2) break;	// TODO, support 'jt' entry of Fly2+
 
-				const float current_joystick_state = flystick_frame_data->m_joystick_state[i];
+				const float current_joystick_state = flystick_frame_data->m_joystick_values[i];
 				if (current_joystick_state != flystick_state.m_joysticks_state[i])
 				{
 					flystick_changed = true;
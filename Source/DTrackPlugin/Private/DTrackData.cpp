@@ -35,6 +35,17 @@
 
 #include "DTrackDataTypes.hpp"
 
+#if defined( __AVX__ )
+	#include <immintrin.h>
+	#define DTRACKDATA_AVX
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || defined( _M_AMD64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+	#include <emmintrin.h>
+	#define DTRACKDATA_SSE2
+#elif ( defined( __ARM_NEON ) && defined( __aarch64__ ) ) || defined( _M_ARM64 )
+	#include <arm_neon.h>
+	#define DTRACKDATA_NEON
+#endif
+
 namespace DTrackSDK_Datatypes {
 
 // -----------------------------------------------------------------------------------------------------
@@ -105,5 +116,146 @@ DTrackQuaternion rot2quat( const double rot[ 9 ] )
 }
 
 
+
+// -----------------------------------------------------------------------------------------------------
+
+// Minimal vector operations for several doubles at once, used by rot2quat() for pose arrays.
+
+#if defined( DTRACKDATA_AVX )
+
+typedef __m256d quat_vd;  // 4 doubles
+typedef __m256d quat_vm;  // mask of 4 doubles
+static const int QUAT_LANES = 4;
+
+static inline quat_vd vd_load( const double* p )  { return _mm256_loadu_pd( p ); }
+static inline void vd_store( double* p, quat_vd a )  { _mm256_storeu_pd( p, a ); }
+static inline quat_vd vd_set1( double d )  { return _mm256_set1_pd( d ); }
+static inline quat_vd vd_add( quat_vd a, quat_vd b )  { return _mm256_add_pd( a, b ); }
+static inline quat_vd vd_sub( quat_vd a, quat_vd b )  { return _mm256_sub_pd( a, b ); }
+static inline quat_vd vd_mul( quat_vd a, quat_vd b )  { return _mm256_mul_pd( a, b ); }
+static inline quat_vd vd_div( quat_vd a, quat_vd b )  { return _mm256_div_pd( a, b ); }
+static inline quat_vd vd_sqrt( quat_vd a )  { return _mm256_sqrt_pd( a ); }
+static inline quat_vm vd_gt( quat_vd a, quat_vd b )  { return _mm256_cmp_pd( a, b, _CMP_GT_OQ ); }
+static inline quat_vm vm_and( quat_vm a, quat_vm b )  { return _mm256_and_pd( a, b ); }
+static inline quat_vd vd_select( quat_vm m, quat_vd a, quat_vd b )  { return _mm256_blendv_pd( b, a, m ); }
+
+#elif defined( DTRACKDATA_SSE2 )
+
+typedef __m128d quat_vd;  // 2 doubles
+typedef __m128d quat_vm;  // mask of 2 doubles
+static const int QUAT_LANES = 2;
+
+static inline quat_vd vd_load( const double* p )  { return _mm_loadu_pd( p ); }
+static inline void vd_store( double* p, quat_vd a )  { _mm_storeu_pd( p, a ); }
+static inline quat_vd vd_set1( double d )  { return _mm_set1_pd( d ); }
+static inline quat_vd vd_add( quat_vd a, quat_vd b )  { return _mm_add_pd( a, b ); }
+static inline quat_vd vd_sub( quat_vd a, quat_vd b )  { return _mm_sub_pd( a, b ); }
+static inline quat_vd vd_mul( quat_vd a, quat_vd b )  { return _mm_mul_pd( a, b ); }
+static inline quat_vd vd_div( quat_vd a, quat_vd b )  { return _mm_div_pd( a, b ); }
+static inline quat_vd vd_sqrt( quat_vd a )  { return _mm_sqrt_pd( a ); }
+static inline quat_vm vd_gt( quat_vd a, quat_vd b )  { return _mm_cmpgt_pd( a, b ); }
+static inline quat_vm vm_and( quat_vm a, quat_vm b )  { return _mm_and_pd( a, b ); }
+static inline quat_vd vd_select( quat_vm m, quat_vd a, quat_vd b )  { return _mm_or_pd( _mm_and_pd( m, a ), _mm_andnot_pd( m, b ) ); }
+
+#elif defined( DTRACKDATA_NEON )
+
+typedef float64x2_t quat_vd;  // 2 doubles
+typedef uint64x2_t quat_vm;   // mask of 2 doubles
+static const int QUAT_LANES = 2;
+
+static inline quat_vd vd_load( const double* p )  { return vld1q_f64( p ); }
+static inline void vd_store( double* p, quat_vd a )  { vst1q_f64( p, a ); }
+static inline quat_vd vd_set1( double d )  { return vdupq_n_f64( d ); }
+static inline quat_vd vd_add( quat_vd a, quat_vd b )  { return vaddq_f64( a, b ); }
+static inline quat_vd vd_sub( quat_vd a, quat_vd b )  { return vsubq_f64( a, b ); }
+static inline quat_vd vd_mul( quat_vd a, quat_vd b )  { return vmulq_f64( a, b ); }
+static inline quat_vd vd_div( quat_vd a, quat_vd b )  { return vdivq_f64( a, b ); }
+static inline quat_vd vd_sqrt( quat_vd a )  { return vsqrtq_f64( a ); }
+static inline quat_vm vd_gt( quat_vd a, quat_vd b )  { return vcgtq_f64( a, b ); }
+static inline quat_vm vm_and( quat_vm a, quat_vm b )  { return vandq_u64( a, b ); }
+static inline quat_vd vd_select( quat_vm m, quat_vd a, quat_vd b )  { return vbslq_f64( m, a, b ); }
+
+#else
+
+static const int QUAT_LANES = 1;  // no vector operations, just rot2quat() per entry
+
+#endif
+
+
+/*
+ * Helper to convert the rotation matrices of several poses into quaternions, in one pass.
+ *
+ * Takes the same case as rot2quat() per entry (positive trace, else largest diagonal element),
+ * but as a selection between all cases instead of a branch, so all lanes run the same instructions.
+ */
+void rot2quat( DTrackPoseArrays& poses )
+{
+	const int num = poses.num;
+	int i = 0;
+
+	for ( int k = 0; k < 4; k++ )
+		poses.quat[ k ].resize( num );
+
+	double* qw = poses.quat[ 0 ].data();
+	double* qx = poses.quat[ 1 ].data();
+	double* qy = poses.quat[ 2 ].data();
+	double* qz = poses.quat[ 3 ].data();
+
+#if defined( DTRACKDATA_AVX ) || defined( DTRACKDATA_SSE2 ) || defined( DTRACKDATA_NEON )
+	const quat_vd zero = vd_set1( 0.0 );
+	const quat_vd one = vd_set1( 1.0 );
+	const quat_vd half = vd_set1( 0.5 );
+
+	for ( ; i + QUAT_LANES <= num; i += QUAT_LANES )
+	{
+		quat_vd r[ 9 ];
+		for ( int k = 0; k < 9; k++ )
+			r[ k ] = vd_load( poses.rot[ k ].data() + i );
+
+		// cases of rot2quat(): positive trace, else largest of rot[0], rot[4], rot[8]:
+		const quat_vd tr = vd_add( vd_add( r[ 0 ], r[ 4 ] ), r[ 8 ] );
+		const quat_vm is_w = vd_gt( tr, zero );
+		const quat_vm is_x = vm_and( vd_gt( r[ 0 ], r[ 4 ] ), vd_gt( r[ 0 ], r[ 8 ] ) );
+		const quat_vm is_y = vd_gt( r[ 4 ], r[ 8 ] );
+
+		const quat_vd t_w = vd_add( one, tr );
+		const quat_vd t_x = vd_sub( vd_sub( vd_add( one, r[ 0 ] ), r[ 4 ] ), r[ 8 ] );
+		const quat_vd t_y = vd_sub( vd_add( vd_sub( one, r[ 0 ] ), r[ 4 ] ), r[ 8 ] );
+		const quat_vd t_z = vd_add( vd_sub( vd_sub( one, r[ 0 ] ), r[ 4 ] ), r[ 8 ] );
+
+		const quat_vd s = vd_sqrt( vd_select( is_w, t_w, vd_select( is_x, t_x, vd_select( is_y, t_y, t_z ) ) ) );
+		const quat_vd h = vd_mul( half, s );
+		const quat_vd f = vd_div( half, s );  // = 1 / (4 * largest component)
+
+		const quat_vd d_x = vd_mul( vd_sub( r[ 5 ], r[ 7 ] ), f );
+		const quat_vd d_y = vd_mul( vd_sub( r[ 6 ], r[ 2 ] ), f );
+		const quat_vd d_z = vd_mul( vd_sub( r[ 1 ], r[ 3 ] ), f );
+		const quat_vd s_xy = vd_mul( vd_add( r[ 1 ], r[ 3 ] ), f );
+		const quat_vd s_xz = vd_mul( vd_add( r[ 2 ], r[ 6 ] ), f );
+		const quat_vd s_yz = vd_mul( vd_add( r[ 5 ], r[ 7 ] ), f );
+
+		vd_store( qw + i, vd_select( is_w, h,   vd_select( is_x, d_x,  vd_select( is_y, d_y,  d_z ) ) ) );
+		vd_store( qx + i, vd_select( is_w, d_x, vd_select( is_x, h,    vd_select( is_y, s_xy, s_xz ) ) ) );
+		vd_store( qy + i, vd_select( is_w, d_y, vd_select( is_x, s_xy, vd_select( is_y, h,    s_yz ) ) ) );
+		vd_store( qz + i, vd_select( is_w, d_z, vd_select( is_x, s_xz, vd_select( is_y, s_yz, h ) ) ) );
+	}
+#endif
+
+	// remaining entries:
+	for ( ; i < num; i++ )
+	{
+		double rot[ 9 ];
+		for ( int k = 0; k < 9; k++ )
+			rot[ k ] = poses.rot[ k ][ i ];
+
+		const DTrackQuaternion quat = rot2quat( rot );
+		qw[ i ] = quat.w;
+		qx[ i ] = quat.x;
+		qy[ i ] = quat.y;
+		qz[ i ] = quat.z;
+	}
+}
+
+
 }  // namespace DTrackSDK_Datatypes
 
@@ -34,6 +34,9 @@
 #ifndef _ART_DTRACKSDK_DATATYPES_HPP_
 #define _ART_DTRACKSDK_DATATYPES_HPP_
 
+#include <cstddef>
+#include <vector>
+
 namespace DTrackSDK_Datatypes {
 
 /**
@@ -306,7 +309,8 @@ typedef DTrackHand DTrack_Hand_Type_d;  //!< Alias for DTrackHand. DEPRECATED.
 /**
  * \brief ART-Human model (joints (6DOF) including optional Fingertracking).
  *
- * Note the maximum number of joints.
+ * Joint data of all human models is stored contiguously by the parser, just for the joints
+ * that are tracked. It is valid until the next frame is received.
  */
 struct DTrackHuman
 {
@@ -347,11 +351,79 @@ struct DTrackHuman
 		 */
 		DTrackQuaternion getQuaternion() const
 		{ return rot2quat( rot ); }
-	} joint[ DTRACKSDK_HUMAN_MAX_JOINTS ];  //!< Joint data
+	};
+
+	DTrackJoint* joint;  //!< Joint data (num_joints entries); NULL if not tracked
+
+	/**
+	 * \brief Returns joint data.
+	 *
+	 * @param[in] index Index of joint, range 0 .. num_joints - 1
+	 * @return          Joint data; NULL in case of error
+	 */
+	const DTrackJoint* getJoint( int index ) const
+	{ return ( ( index >= 0 ) && ( index < num_joints ) ) ? &joint[ index ] : NULL; }
 };
 
 typedef DTrackHuman DTrack_Human_Type_d;  //!< Alias for DTrackHuman. DEPRECATED.
 
+// -----------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Poses (6DOF) of several bodies, stored as structure of arrays.
+ *
+ * Entry i of all arrays belongs to the same body. Allows to convert all poses in one pass, without
+ * touching further data like covariances.
+ */
+struct DTrackPoseArrays
+{
+	int num;                           //!< Number of entries
+	std::vector< int > id;             //!< ID number (starting with 0)
+	std::vector< double > quality;     //!< Quality (0.0 <= qu <= 1.0, no tracking if -1.0)
+	std::vector< double > loc_x;       //!< Location, x-coordinate (in [mm])
+	std::vector< double > loc_y;       //!< Location, y-coordinate (in [mm])
+	std::vector< double > loc_z;       //!< Location, z-coordinate (in [mm])
+	std::vector< double > rot[ 9 ];    //!< Rotation matrix (column-wise), one array per element
+	std::vector< double > quat[ 4 ];   //!< Rotation as quaternion (w, x, y, z), one array per component
+
+	DTrackPoseArrays() : num( 0 ) {}
+};
+
+/**
+ * \brief Helper to convert the rotation matrices of several poses into quaternions, in one pass.
+ *
+ * Fills the quaternion arrays. Gives exactly the same results as rot2quat() for each entry, but converts
+ * several entries at once (vectorized if SSE2/AVX/NEON is available).
+ *
+ * @param[in,out] poses Poses
+ */
+void rot2quat( DTrackPoseArrays& poses );
+
+// -----------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Snapshot of the tracking data of one frame.
+ *
+ * Contains the calibrated standard bodies, Flysticks, Measurement Tools, Fingertracking hands, ART-Human
+ * models, hybrid bodies and the tracked single markers. The joints of the ART-Human models point into
+ * human_joint of the same frame.
+ */
+struct DTrackFrame
+{
+	unsigned int framecounter;                  //!< Frame counter
+	double timestamp;                           //!< Timestamp (-1, if information not available)
+	std::vector< DTrackBody > body;             //!< Standard body data
+	std::vector< DTrackFlyStick > flystick;     //!< Flystick data
+	std::vector< DTrackMeaTool > meatool;       //!< Measurement Tool data
+	std::vector< DTrackHand > hand;             //!< A.R.T. FINGERTRACKING hand data
+	std::vector< DTrackHuman > human;           //!< ART-Human model data
+	std::vector< DTrackHuman::DTrackJoint > human_joint;  //!< Joint data of all ART-Human models
+	std::vector< DTrackInertial > inertial;     //!< Hybrid (optical-inertial) body data
+	std::vector< DTrackMarker > marker;         //!< Single marker data
+
+	DTrackFrame() : framecounter( 0 ), timestamp( -1 ) {}
+};
+
 
 }  // namespace DTrackSDK_Datatypes
 
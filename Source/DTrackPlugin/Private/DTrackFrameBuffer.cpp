@@ -0,0 +1,147 @@
+/* DTrackFrameBuffer: C++ source file
+ *
+ * DTrackSDK: publication of tracking data frames to other threads.
+ *
+ * Copyright 2013-2021, Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Version v2.7.0
+ * 
+ */
+
+#include "DTrackFrameBuffer.hpp"
+
+#include <cstddef>
+
+
+/*
+ * Constructor.
+ */
+DTrackFrameBuffer::DTrackFrameBuffer( int maxReaders )
+{
+	if (maxReaders < 1)
+		maxReaders = 1;
+	if (maxReaders > DTRACKSDK_FRAMEBUFFER_MAX_READERS)
+		maxReaders = DTRACKSDK_FRAMEBUFFER_MAX_READERS;
+	
+	num_frames = maxReaders + 2;  // one held by each reader, latest one and one being filled
+	for (int i=0; i<MAX_FRAMES; i++)
+		refs[i] = 0;
+	
+	latest = -1;
+	writing = -1;
+	dropped = 0;
+}
+
+
+/*
+ * Destructor.
+ */
+DTrackFrameBuffer::~DTrackFrameBuffer()
+{
+	//
+}
+
+
+/*
+ * Get frame to be filled by the writer.
+ */
+DTrackFrame* DTrackFrameBuffer::beginWrite()
+{
+	int act_latest = latest.load();
+	
+	// any frame, that is neither the latest one nor held by a reader:
+	for (int i=0; i<num_frames; i++) {
+		if (i != act_latest && refs[i].load() == 0) {
+			writing = i;
+			return &frames[i];
+		}
+	}
+	
+	writing = -1;
+	dropped++;
+	return NULL;
+}
+
+
+/*
+ * Publish frame filled by the writer as latest frame.
+ */
+void DTrackFrameBuffer::endWrite()
+{
+	if (writing < 0)
+		return;
+	
+	latest.store(writing);
+	writing = -1;
+}
+
+
+/*
+ * Get latest complete frame.
+ *
+ * A reader announces its frame first, then checks if it is still the latest one: a frame, that is
+ * not the latest one anymore, could already be refilled by the writer.
+ */
+const DTrackFrame* DTrackFrameBuffer::acquireLatest()
+{
+	int i = latest.load();
+	
+	while (i >= 0) {
+		refs[i]++;
+		
+		int act_latest = latest.load();
+		if (act_latest == i)
+			return &frames[i];
+		
+		refs[i]--;  // writer published a newer frame meanwhile
+		i = act_latest;
+	}
+	
+	return NULL;
+}
+
+
+/*
+ * Release frame acquired by acquireLatest().
+ */
+void DTrackFrameBuffer::release( const DTrackFrame* frame )
+{
+	if (frame == NULL)
+		return;
+	
+	int i = (int )(frame - frames);
+	if (i >= 0 && i < num_frames)
+		refs[i]--;
+}
+
+
+/*
+ * Get number of frames dropped by the writer, as all frames were in use.
+ */
+unsigned int DTrackFrameBuffer::getNumDroppedFrames() const
+{
+	return dropped.load();
+}
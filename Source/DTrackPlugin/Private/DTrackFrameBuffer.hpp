@@ -0,0 +1,124 @@
+/* DTrackFrameBuffer: C++ header file
+ *
+ * DTrackSDK: publication of tracking data frames to other threads.
+ *
+ * Copyright 2013-2021, Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Version v2.7.0
+ * 
+ */
+
+#ifndef _ART_DTRACKSDK_FRAMEBUFFER_HPP_
+#define _ART_DTRACKSDK_FRAMEBUFFER_HPP_
+
+#include "DTrackDataTypes.hpp"
+
+#include <atomic>
+
+using namespace DTrackSDK_Datatypes;
+
+#define DTRACKSDK_FRAMEBUFFER_MAX_READERS 8  //!< Maximum number of frames held by readers at the same time
+
+/**
+ * \brief Buffer to publish the latest frame of tracking data to other threads.
+ *
+ * One writer (usually the thread receiving tracking data) fills frames, any number of reader threads
+ * get the newest complete frame without locks. Works like a triple buffer, with one additional frame
+ * for each frame held by a reader.
+ *
+ * Readers have to release each acquired frame. If all frames are held by readers, the writer drops
+ * new frames until one is released.
+ */
+class DTrackFrameBuffer
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 *
+	 * @param[in] maxReaders Maximum number of frames held by readers at the same time, range 1 .. DTRACKSDK_FRAMEBUFFER_MAX_READERS
+	 */
+	DTrackFrameBuffer( int maxReaders = 2 );
+
+	/**
+	 * \brief Destructor.
+	 */
+	~DTrackFrameBuffer();
+
+	/**
+	 * \brief Get frame to be filled by the writer.
+	 *
+	 * Has to be published by endWrite().
+	 *
+	 * @return Frame; NULL if all frames are in use (frame has to be dropped)
+	 */
+	DTrackFrame* beginWrite();
+
+	/**
+	 * \brief Publish frame filled by the writer as latest frame.
+	 */
+	void endWrite();
+
+	/**
+	 * \brief Get latest complete frame.
+	 *
+	 * Lock-free, can be called by any thread. The frame stays unchanged until released by release().
+	 *
+	 * @return Frame; NULL if no frame was published yet
+	 */
+	const DTrackFrame* acquireLatest();
+
+	/**
+	 * \brief Release frame acquired by acquireLatest().
+	 *
+	 * @param[in] frame Frame
+	 */
+	void release( const DTrackFrame* frame );
+
+	/**
+	 * \brief Get number of frames dropped by the writer, as all frames were in use.
+	 *
+	 * @return Number of dropped frames
+	 */
+	unsigned int getNumDroppedFrames() const;
+
+private:
+
+	DTrackFrameBuffer( const DTrackFrameBuffer& );             // not copyable
+	DTrackFrameBuffer& operator=( const DTrackFrameBuffer& );
+
+	static const int MAX_FRAMES = DTRACKSDK_FRAMEBUFFER_MAX_READERS + 2;
+
+	int num_frames;                          //!< Number of used frames
+	DTrackFrame frames[ MAX_FRAMES ];        //!< Frames
+	std::atomic< int > refs[ MAX_FRAMES ];   //!< Number of readers holding each frame
+	std::atomic< int > latest;               //!< Index of latest complete frame (-1 if not available)
+	int writing;                             //!< Index of frame filled by writer (-1 if none)
+	std::atomic< unsigned int > dropped;     //!< Number of frames dropped by writer
+};
+
+
+#endif  // _ART_DTRACKSDK_FRAMEBUFFER_HPP_
@@ -63,6 +63,23 @@ bool UDTrackFlystickInputRole::InitializeBlueprintData(const FLiveLinkSubjectFra
 	{
 		GetStaticDataStruct()->CopyScriptStruct(&blueprint_data->m_static_data, static_data);
 		GetFrameDataStruct()->CopyScriptStruct(&blueprint_data->m_frame_data, frame_data);
+
+		// arrays for Blueprints are just built on request, pushed frames carry the fixed size states only
+		FDTrackFlystickInputFrameData& blueprint_frame = blueprint_data->m_frame_data;
+		if (frame_data->m_button_state.Num() == 0 && frame_data->m_joystick_state.Num() == 0) {
+			const int32 button_count = FMath::Clamp(static_data->m_button_count, 0, 31);
+			blueprint_frame.m_button_state.SetNumUninitialized(button_count);
+			for (int32 i = 0; i < button_count; ++i) {
+				blueprint_frame.m_button_state[i] = (frame_data->m_button_mask & (1 << i)) != 0;
+			}
+
+			const int32 joystick_count = FMath::Clamp(static_data->m_joystick_count, 0, DTRACK_FLYSTICK_MAX_JOYSTICK);
+			blueprint_frame.m_joystick_state.SetNumUninitialized(joystick_count);
+			for (int32 i = 0; i < joystick_count; ++i) {
+				blueprint_frame.m_joystick_state[i] = frame_data->m_joystick_values[i];
+			}
+		}
+
 		is_success = true;
 	}
 
@@ -76,6 +76,7 @@ void FDTrackLiveLinkSource::InitializeSettings(ULiveLinkSourceSettings* InSettin
 
 	m_source_settings = CastChecked<UDTrackLiveLinkSourceSettings>(InSettings);
 	reset_datamaps();
+	update_subject_prefixes(m_source_settings->m_server_settings);
 	m_sdk_handler->start_listening(m_source_settings->m_server_settings);
 
 	switch (m_source_settings->m_server_settings.m_coordinate_system) {
@@ -120,16 +121,19 @@ void FDTrackLiveLinkSource::OnSettingsChanged(ULiveLinkSourceSettings* InSetting
 
 			m_current_server_settings = m_source_settings->m_server_settings;
 
+			const double restart_begin = FPlatformTime::Seconds();
 			m_sdk_handler->stop_listening();
 
 			reset_datamaps();
+			update_subject_prefixes(m_source_settings->m_server_settings);
 
 			m_sdk_handler->start_listening(m_source_settings->m_server_settings);
+			UE_LOG(LogDTrackPlugin, Verbose, TEXT("Restarted tracking in %.2f ms."), (FPlatformTime::Seconds() - restart_begin) * 1000.0);
 		}
 	}
 }
 
-void FDTrackLiveLinkSource::handle_body_data_anythread(double n_worldtime, double n_timestamp, int32 n_itemId, float n_quality, const FVector& n_location, const FRotator& n_rotation) {
+void FDTrackLiveLinkSource::handle_body_data_anythread(double n_worldtime, double n_timestamp, int32 n_source, int32 n_itemId, float n_quality, const FVector& n_location, const FQuat& n_rotation) {
 
 	//When quality is below 0, the body was not visible by tracking system
 	if (n_quality <= 0.0f) {
@@ -137,20 +141,21 @@ void FDTrackLiveLinkSource::handle_body_data_anythread(double n_worldtime, doubl
 	}
 
 	FLiveLinkSubjectKey key;
+	const FDTrackItemKey item_key(n_source, n_itemId);
 
 	{
 		FScopeLock Lock(&m_data_access_criticalsection);
 
-		if (const FLiveLinkSubjectKey* found_ptr = m_body_subjects.Find(n_itemId)) {
+		if (const FLiveLinkSubjectKey* found_ptr = m_body_subjects.Find(item_key)) {
 
 			key = *found_ptr;
 		}
 		else {
 
 			//Body data always consists of Location and Rotation. No need to make verification to resend static data
-			const FString subject_name = FString::Printf(TEXT("DTrack-Body-%02d"), n_itemId);
+			const FString subject_name = FString::Printf(TEXT("%s-Body-%02d"), *get_subject_prefix(n_source), n_itemId);
 			key = FLiveLinkSubjectKey(m_source_guid, *subject_name);
-			m_body_subjects.Add(n_itemId, key);
+			m_body_subjects.Add(item_key, key);
 
 			FLiveLinkStaticDataStruct static_data(FLiveLinkTransformStaticData::StaticStruct());
 			m_client->PushSubjectStaticData_AnyThread(key, ULiveLinkTransformRole::StaticClass(), MoveTemp(static_data));
@@ -161,7 +166,7 @@ void FDTrackLiveLinkSource::handle_body_data_anythread(double n_worldtime, doubl
 	FLiveLinkFrameDataStruct frame_data(FLiveLinkTransformFrameData::StaticStruct());
 	FLiveLinkTransformFrameData* transform_data = frame_data.Cast<FLiveLinkTransformFrameData>();
 	transform_data->Transform.SetLocation(n_location);
-	transform_data->Transform.SetRotation(n_rotation.Quaternion());
+	transform_data->Transform.SetRotation(n_rotation);
 	transform_data->Transform.SetScale3D(FVector(1.0f, 1.0f, 1.0f));
 
 	transform_data->WorldTime = FLiveLinkWorldTime(n_worldtime, 0.0);
@@ -170,34 +175,35 @@ void FDTrackLiveLinkSource::handle_body_data_anythread(double n_worldtime, doubl
 	m_client->PushSubjectFrameData_AnyThread(key, MoveTemp(frame_data));
 }
 
-void FDTrackLiveLinkSource::handle_flystick_data_anythread(double n_worldtime, double n_timestamp, int32 n_itemId, float n_quality, const FVector& n_location, const FRotator& n_rotation, TArray<bool>& n_temp_buttons, TArray<float>& n_temp_joysticks) {
+void FDTrackLiveLinkSource::handle_flystick_data_anythread(double n_worldtime, double n_timestamp, int32 n_source, int32 n_itemId, float n_quality, const FVector& n_location, const FQuat& n_rotation, int32 n_button_count, int32 n_button_mask, int32 n_joystick_count, const float* n_joysticks) {
 
 	//Handle flystick with transform and inputs
-	handle_flystick_input_anythread(n_worldtime, n_timestamp, n_itemId, n_temp_buttons, n_temp_joysticks);
+	handle_flystick_input_anythread(n_worldtime, n_timestamp, n_source, n_itemId, n_button_count, n_button_mask, n_joystick_count, n_joysticks);
 
 	//Also create a subject only for transform data if quality is good
 	if (n_quality > 0.0f)
 	{
-		handle_flystick_body_anythread(n_worldtime, n_timestamp, n_itemId, n_quality, n_location, n_rotation);
+		handle_flystick_body_anythread(n_worldtime, n_timestamp, n_source, n_itemId, n_quality, n_location, n_rotation);
 	}
 }
 
-void FDTrackLiveLinkSource::handle_flystick_body_anythread(double n_worldtime, double n_timestamp, int32 n_itemId, float n_quality, const FVector& n_location, const FRotator& n_rotation) {
+void FDTrackLiveLinkSource::handle_flystick_body_anythread(double n_worldtime, double n_timestamp, int32 n_source, int32 n_itemId, float n_quality, const FVector& n_location, const FQuat& n_rotation) {
 
 	FLiveLinkSubjectKey key;
+	const FDTrackItemKey item_key(n_source, n_itemId);
 	{
 		FScopeLock Lock(&m_data_access_criticalsection);
 
-		if (const FLiveLinkSubjectKey* found_ptr = m_flystick_body_subjects.Find(n_itemId)) {
+		if (const FLiveLinkSubjectKey* found_ptr = m_flystick_body_subjects.Find(item_key)) {
 
 			key = *found_ptr;
 		}
 		else {
 
 			//Flystick transform only data always consists of Location and Rotation. No need to make verification to resend static data
-			const FString subject_name = FString::Printf(TEXT("DTrack-FlystickBody-%02d"), n_itemId);
+			const FString subject_name = FString::Printf(TEXT("%s-FlystickBody-%02d"), *get_subject_prefix(n_source), n_itemId);
 			key = FLiveLinkSubjectKey(m_source_guid, *subject_name);
-			m_flystick_body_subjects.Add(n_itemId, key);
+			m_flystick_body_subjects.Add(item_key, key);
 
 			FLiveLinkStaticDataStruct static_data(FLiveLinkTransformStaticData::StaticStruct());
 			m_client->PushSubjectStaticData_AnyThread(key, ULiveLinkTransformRole::StaticClass(), MoveTemp(static_data));
@@ -208,7 +214,7 @@ void FDTrackLiveLinkSource::handle_flystick_body_anythread(double n_worldtime, d
 	FLiveLinkFrameDataStruct frame_data(FLiveLinkTransformFrameData::StaticStruct());
 	FLiveLinkTransformFrameData* transform_data = frame_data.Cast<FLiveLinkTransformFrameData>();
 	transform_data->Transform.SetLocation(n_location);
-	transform_data->Transform.SetRotation(n_rotation.Quaternion());
+	transform_data->Transform.SetRotation(n_rotation);
 	transform_data->Transform.SetScale3D(FVector(1.0f, 1.0f, 1.0f));
 
 	transform_data->WorldTime = FLiveLinkWorldTime(n_worldtime, 0.0);
@@ -218,7 +224,7 @@ void FDTrackLiveLinkSource::handle_flystick_body_anythread(double n_worldtime, d
 }
 
 
-void FDTrackLiveLinkSource::handle_flystick_input_anythread(double n_worldtime, double n_timestamp, int32 n_itemId, TArray<bool>& n_temp_buttons, TArray<float>& n_temp_joysticks)
+void FDTrackLiveLinkSource::handle_flystick_input_anythread(double n_worldtime, double n_timestamp, int32 n_source, int32 n_itemId, int32 n_button_count, int32 n_button_mask, int32 n_joystick_count, const float* n_joysticks)
 {
 	// Check if our LiveLink client tries to use subjects we dont know about
 	if ( m_flystick_input_subjects.Num() == 0 )
@@ -235,18 +241,19 @@ void FDTrackLiveLinkSource::handle_flystick_input_anythread(double n_worldtime,
 
 
 	FLiveLinkSubjectKey key;
+	const FDTrackItemKey item_key(n_source, n_itemId);
 	{
 		FScopeLock Lock(&m_data_access_criticalsection);
 
 		bool bNeedToUpdateStaticData = false;
-		if (const FLiveLinkSubjectKey* found_ptr = m_flystick_input_subjects.Find(n_itemId)) {
+		if (const FLiveLinkSubjectKey* found_ptr = m_flystick_input_subjects.Find(item_key)) {
 
 			//Subject exists. Make sure its data match what was previously received
 			key = *found_ptr;
 
 			if (const FDTrackFlystickInputStaticData* found_data = m_flystick_input_static_data_map.Find(key.SubjectName.Name)) {
 
-				if (found_data->m_button_count != n_temp_buttons.Num() || found_data->m_joystick_count != n_temp_joysticks.Num()) {
+				if (found_data->m_button_count != n_button_count || found_data->m_joystick_count != n_joystick_count) {
 
 					bNeedToUpdateStaticData = true;
 				}
@@ -254,9 +261,9 @@ void FDTrackLiveLinkSource::handle_flystick_input_anythread(double n_worldtime,
 		}
 		else {
 
-			const FString subject_name = FString::Printf(TEXT("DTrack-FlystickInput-%02d"), n_itemId);
+			const FString subject_name = FString::Printf(TEXT("%s-FlystickInput-%02d"), *get_subject_prefix(n_source), n_itemId);
 			key = FLiveLinkSubjectKey(m_source_guid, *subject_name);
-			m_flystick_input_subjects.Add(n_itemId, key);
+			m_flystick_input_subjects.Add(item_key, key);
 
 			bNeedToUpdateStaticData = true;
 		}
@@ -266,8 +273,8 @@ void FDTrackLiveLinkSource::handle_flystick_input_anythread(double n_worldtime,
 			FLiveLinkStaticDataStruct static_data(FDTrackFlystickInputStaticData::StaticStruct());
 			FDTrackFlystickInputStaticData* flystick_static_data = static_data.Cast<FDTrackFlystickInputStaticData>();
 			flystick_static_data->m_flystick_id = n_itemId;
-			flystick_static_data->m_button_count = n_temp_buttons.Num();
-			flystick_static_data->m_joystick_count = n_temp_joysticks.Num();
+			flystick_static_data->m_button_count = n_button_count;
+			flystick_static_data->m_joystick_count = n_joystick_count;
 
 			m_client->PushSubjectStaticData_AnyThread(key, UDTrackFlystickInputRole::StaticClass(), MoveTemp(static_data));
 			
@@ -280,17 +287,10 @@ void FDTrackLiveLinkSource::handle_flystick_input_anythread(double n_worldtime,
 	FLiveLinkFrameDataStruct frame_data(FDTrackFlystickInputFrameData::StaticStruct());
 	FDTrackFlystickInputFrameData* flystick_data = frame_data.Cast<FDTrackFlystickInputFrameData>();
 
-	flystick_data->m_button_state.Reserve(n_temp_buttons.Num());
-	flystick_data->m_joystick_state.Reserve(n_temp_joysticks.Num());
-	for (int32 i = 0; i < n_temp_buttons.Num(); ++i) {
-
-		flystick_data->m_button_state.Add(n_temp_buttons[i]);
-	}
-
-	for (int32 i = 0; i < n_temp_joysticks.Num(); ++i) {
-
-		flystick_data->m_joystick_state.Add(n_temp_joysticks[i]);
-	}
+	// fixed size states, no allocations per frame
+	check(n_joystick_count <= DTRACK_FLYSTICK_MAX_JOYSTICK);
+	flystick_data->m_button_mask = n_button_mask;
+	FMemory::Memcpy(flystick_data->m_joystick_values, n_joysticks, n_joystick_count * sizeof(float));
 
 	flystick_data->WorldTime = FLiveLinkWorldTime(n_worldtime, 0.0);
 	const FFrameRate rate = FApp::GetTimecodeFrameRate();
@@ -300,27 +300,28 @@ void FDTrackLiveLinkSource::handle_flystick_input_anythread(double n_worldtime,
 
 
 void FDTrackLiveLinkSource::handle_hand_data_anythread(
-	double n_worldtime, double n_timestamp, int32 n_itemId, 
+	double n_worldtime, double n_timestamp, int32 n_source, int32 n_itemId, 
 	float n_quality, bool n_is_right_hand, 
 	const FTransform& n_transform, 
-	TArray<EDTrackFingerType>& n_temp_fingers_type, 
-	TArray<FDTrackFinger>& n_temp_fingers ) 
+	TArrayView<const EDTrackFingerType> n_fingers_type, 
+	TArrayView<const FDTrackFinger> n_fingers ) 
 {
 	//When quality is below 0, the body was not visible by tracking system
 	if (n_quality <= 0.0f) {
 		return;
 	}
 
-	check(n_temp_fingers_type.Num() == n_temp_fingers.Num());
+	check(n_fingers_type.Num() == n_fingers.Num());
 
 	FLiveLinkSubjectKey key;
-	const int32 bone_count = 1 + 4 * n_temp_fingers_type.Num(); //4 bones per finger + 1 for the hand
-	const int32 property_count = n_temp_fingers_type.Num() * 1; //tip radius per finger
+	const FDTrackItemKey item_key(n_source, n_itemId);
+	const int32 bone_count = 1 + 4 * n_fingers_type.Num(); //4 bones per finger + 1 for the hand
+	const int32 property_count = n_fingers_type.Num() * 1; //tip radius per finger
 
 	{	FScopeLock Lock(&m_data_access_criticalsection);
 
 		bool bNeedToUpdateStaticData = false;
-		if ( const FLiveLinkSubjectKey* found_ptr = m_hand_subjects.Find( n_itemId ) ) {
+		if ( const FLiveLinkSubjectKey* found_ptr = m_hand_subjects.Find(item_key) ) {
 
 			//Subject exists. Make sure its data match what was previously received
 			key = *found_ptr;
@@ -328,16 +329,18 @@ void FDTrackLiveLinkSource::handle_hand_data_anythread(
 			if (const FDTrackHandStaticData* found_data = m_hand_static_data_map.Find(key.SubjectName.Name))
 			{
 				//Verify if we have the same number of fingers (1 bone for the hand + n bones for the fingers) and that it's the same hand side
-				if (found_data->m_fingers_type != n_temp_fingers_type || found_data->m_is_right_hand != n_is_right_hand)
+				const bool same_fingers = found_data->m_fingers_type.Num() == n_fingers_type.Num()
+					&& FMemory::Memcmp(found_data->m_fingers_type.GetData(), n_fingers_type.GetData(), n_fingers_type.Num() * sizeof(EDTrackFingerType)) == 0;
+				if (!same_fingers || found_data->m_is_right_hand != n_is_right_hand)
 					bNeedToUpdateStaticData = true;
 			}
 		}
 		else
 		{
 			//Subject doesn't exist. Add it to our map and mark static data update required
-			const FString subject_name = FString::Printf(TEXT("DTrack-%sHand-%02d"), n_is_right_hand ? TEXT("Right") : TEXT("Left"), n_itemId);
+			const FString subject_name = FString::Printf(TEXT("%s-%sHand-%02d"), *get_subject_prefix(n_source), n_is_right_hand ? TEXT("Right") : TEXT("Left"), n_itemId);
 			key = FLiveLinkSubjectKey(m_source_guid, *subject_name);
-			m_hand_subjects.Add(n_itemId, key);
+			m_hand_subjects.Add(item_key, key);
 
 			bNeedToUpdateStaticData = true;
 		}
@@ -348,7 +351,7 @@ void FDTrackLiveLinkSource::handle_hand_data_anythread(
 			FDTrackHandStaticData* hand_static_data = static_data.Cast<FDTrackHandStaticData>();
 
 			hand_static_data->m_is_right_hand = n_is_right_hand;
-			hand_static_data->m_fingers_type = MoveTemp(n_temp_fingers_type);
+			hand_static_data->m_fingers_type = TArray<EDTrackFingerType>(n_fingers_type.GetData(), n_fingers_type.Num());
 
 			hand_static_data->BoneNames.Reserve(bone_count);
 			hand_static_data->BoneParents.Reserve(bone_count); 
@@ -402,7 +405,7 @@ void FDTrackLiveLinkSource::handle_hand_data_anythread(
 	const FDTrackHandStaticData* hand_static_data = m_hand_static_data_map.Find(key.SubjectName.Name);
 	for (int32 i = 0; i < hand_static_data->m_fingers_type.Num(); ++i) 
 	{
-		const FDTrackFinger& finger = n_temp_fingers[i];
+		const FDTrackFinger& finger = n_fingers[i];
 		int32 id_offset = n_is_right_hand ? (int32)EDTrackJointId::thumb_01_r - (int32)EDTrackJointId::thumb_01_l : 0;
 
 		//Inner phalanx related to hand root
@@ -434,7 +437,7 @@ void FDTrackLiveLinkSource::reset_datamaps() {
 	FScopeLock Lock(&m_data_access_criticalsection);
 
 	//Clear bodies that were added
-	for (const TPair<int32, FLiveLinkSubjectKey>& entry : m_body_subjects) {
+	for (const TPair<FDTrackItemKey, FLiveLinkSubjectKey>& entry : m_body_subjects) {
 
 		const FLiveLinkSubjectKey& key = entry.Value;
 		m_client->RemoveSubject_AnyThread(key);
@@ -442,7 +445,7 @@ void FDTrackLiveLinkSource::reset_datamaps() {
 	m_body_subjects.Empty();
 
 	//Clear flystick bodies that were added
-	for (const TPair<int32, FLiveLinkSubjectKey>& entry : m_flystick_body_subjects) {
+	for (const TPair<FDTrackItemKey, FLiveLinkSubjectKey>& entry : m_flystick_body_subjects) {
 
 		const FLiveLinkSubjectKey& key = entry.Value;
 		m_client->RemoveSubject_AnyThread(key);
@@ -450,7 +453,7 @@ void FDTrackLiveLinkSource::reset_datamaps() {
 	m_flystick_body_subjects.Empty();
 
 	//Clear flystick inputs that were added
-	for (const TPair<int32, FLiveLinkSubjectKey>& entry : m_flystick_input_subjects) {
+	for (const TPair<FDTrackItemKey, FLiveLinkSubjectKey>& entry : m_flystick_input_subjects) {
 
 		const FLiveLinkSubjectKey& key = entry.Value;
 		m_client->RemoveSubject_AnyThread(key);
@@ -459,7 +462,7 @@ void FDTrackLiveLinkSource::reset_datamaps() {
 	m_flystick_input_static_data_map.Empty();
 
 	//Clear subjects that were added
-	for (const TPair<int32, FLiveLinkSubjectKey>& entry : m_hand_subjects) {
+	for (const TPair<FDTrackItemKey, FLiveLinkSubjectKey>& entry : m_hand_subjects) {
 
 		const FLiveLinkSubjectKey& key = entry.Value;
 		m_client->RemoveSubject_AnyThread(key);
@@ -468,7 +471,7 @@ void FDTrackLiveLinkSource::reset_datamaps() {
 	m_hand_static_data_map.Empty();
 
 	//Clear subjects that were added
-	for (const TPair<int32, FLiveLinkSubjectKey>& entry : m_human_subjects) {
+	for (const TPair<FDTrackItemKey, FLiveLinkSubjectKey>& entry : m_human_subjects) {
 
 		const FLiveLinkSubjectKey& key = entry.Value;
 		m_client->RemoveSubject_AnyThread(key);
@@ -477,6 +480,43 @@ void FDTrackLiveLinkSource::reset_datamaps() {
 	m_human_static_data_map.Empty();
 }
 
+void FDTrackLiveLinkSource::update_subject_prefixes(const FDTrackServerSettings& n_server_settings) {
+
+	FScopeLock Lock(&m_data_access_criticalsection);
+
+	m_subject_prefixes.Reset(1 + n_server_settings.m_additional_sources.Num());
+	m_subject_prefixes.Add(TEXT("DTrack"));
+	for (int32 i = 0; i < n_server_settings.m_additional_sources.Num(); i++) {
+		const FDTrackAdditionalSource& source = n_server_settings.m_additional_sources[i];
+
+		FString prefix = source.m_subject_prefix.TrimStartAndEnd();
+		if (prefix.IsEmpty()) {
+			prefix = FString::Printf(TEXT("DTrack-%d"), source.m_dtrack_server_port);
+		}
+
+		// subjects of different sources must not share their names
+		if (m_subject_prefixes.Contains(prefix)) {
+			FString unique_prefix = FString::Printf(TEXT("%s-%d"), *prefix, source.m_dtrack_server_port);
+			for (int32 k = 2; m_subject_prefixes.Contains(unique_prefix); k++) {
+				unique_prefix = FString::Printf(TEXT("%s-%d-%d"), *prefix, source.m_dtrack_server_port, k);
+			}
+
+			UE_LOG(LogDTrackPlugin, Warning, TEXT("Subject prefix '%s' of data port '%d' is already used, using '%s' instead."),
+				*prefix, source.m_dtrack_server_port, *unique_prefix);
+			prefix = unique_prefix;
+		}
+
+		m_subject_prefixes.Add(prefix);
+	}
+}
+
+const FString& FDTrackLiveLinkSource::get_subject_prefix(int32 n_source) const {
+
+	static const FString default_prefix(TEXT("DTrack"));
+
+	return m_subject_prefixes.IsValidIndex(n_source) ? m_subject_prefixes[n_source] : default_prefix;
+}
+
 bool FDTrackLiveLinkSource::RequestSourceShutdown() {
 	if(m_sdk_handler.IsValid())
 		m_sdk_handler->Stop();
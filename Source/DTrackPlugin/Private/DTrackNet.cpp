@@ -31,11 +31,19 @@
  * 
  */
 
+#if defined( __linux__ ) && ! defined( _GNU_SOURCE )
+	#define _GNU_SOURCE  // for 'recvmmsg'
+#endif
+
 #include "DTrackNet.hpp"
 
 #include <cstdlib>
 #include <cstdio>
 #include <cstring>
+#include <cerrno>
+#include <vector>
+#include <atomic>
+#include <chrono>
 
 // usually the following should work; otherwise define OS_* manually:
 #if defined(_WIN32) || defined(WIN32) || defined(_WIN64)
@@ -47,11 +55,21 @@
 #ifdef OS_UNIX
 	#include <unistd.h>
 	#include <netdb.h>
+	#include <poll.h>
+	#include <fcntl.h>
 	#include <sys/socket.h>
 	#include <sys/time.h>
 	#include <netinet/in.h>
 	#include <arpa/inet.h>
 #endif
+#if defined( OS_UNIX ) && defined( __linux__ )
+	#include <sys/eventfd.h>
+	#define DTRACKNET_RECVMMSG  // receive several UDP packets per system call
+	#define DTRACKNET_EVENTFD   // wake up waiting receive by eventfd
+	#ifdef SO_TIMESTAMPNS
+		#define DTRACKNET_TIMESTAMPNS  // arrival time of packets taken by kernel (needs 'recvmmsg')
+	#endif
+#endif
 #ifdef OS_WIN
 	#include <ws2tcpip.h>
 	#include <winsock2.h>
@@ -66,9 +84,124 @@ namespace DTrackNet {
 struct _ip_socket_struct {
 #ifdef OS_UNIX
 	int ossock;  // Unix socket
+	int wakefd_r;  // wakeup of waiting receive, read end of eventfd or pipe (-1 if not used)
+	int wakefd_w;  // wakeup of waiting receive, write end of eventfd or pipe (-1 if not used)
 #endif
 #ifdef OS_WIN
 	SOCKET ossock;  // Windows socket
+	SOCKET wakesock;  // wakeup of waiting receive, private loopback socket sending to itself (INVALID_SOCKET if not used)
+	struct sockaddr_in wakeaddr;  // address of wakesock
+#endif
+	std::atomic< bool > interrupted;  // waiting receive was interrupted
+
+#ifdef OS_UNIX
+	_ip_socket_struct() : ossock( -1 ), wakefd_r( -1 ), wakefd_w( -1 ), interrupted( false ) {}
+#endif
+#ifdef OS_WIN
+	_ip_socket_struct() : ossock( INVALID_SOCKET ), wakesock( INVALID_SOCKET ), interrupted( false ) {}
+#endif
+};
+
+
+/**
+ * \brief Waits until a socket is ready to receive or send data.
+ *
+ * Uses poll() on Unix, so there is no limit of the socket number (unlike select() with FD_SETSIZE).
+ *
+ * @param[in] s             Socket
+ * @param[in] forSending    Wait to send data instead of receiving data?
+ * @param[in] toutUs        Timeout in us (micro seconds)
+ * @param[in] interruptible Return if interrupted (see UDP::interrupt())?
+ * @return                  1 if ready, -1 timeout, -2 error, -5 interrupted
+ */
+static int socket_wait( struct _ip_socket_struct* s, bool forSending, int toutUs, bool interruptible )
+{
+	if ( interruptible && s->interrupted )
+		return -5;
+
+#ifdef OS_UNIX
+	struct pollfd fds[ 2 ];
+	int nfds = 1;
+	int err;
+
+	fds[ 0 ].fd = s->ossock;
+	fds[ 0 ].events = forSending ? POLLOUT : POLLIN;
+	fds[ 0 ].revents = 0;
+	if ( interruptible && s->wakefd_r >= 0 )
+	{
+		fds[ 1 ].fd = s->wakefd_r;
+		fds[ 1 ].events = POLLIN;
+		fds[ 1 ].revents = 0;
+		nfds = 2;
+	}
+
+	do {
+		err = poll( fds, nfds, ( toutUs + 999 ) / 1000 );  // in ms, rounded up
+	} while ( err < 0 && errno == EINTR );
+
+	if ( err < 0 )
+		return -2;    // error
+	if ( err == 0 )
+		return -1;    // timeout
+
+	if ( nfds == 2 && ( fds[ 1 ].revents & POLLIN ) )
+		return -5;    // interrupted
+
+	return 1;  // ready (also in case of a socket error, which is reported by the following call)
+#endif
+#ifdef OS_WIN
+	fd_set set, wakeset;
+	fd_set* readset = forSending ? &wakeset : &set;
+	bool wakeable = interruptible && s->wakesock != INVALID_SOCKET;
+	struct timeval tout;
+	int err;
+
+	FD_ZERO( &set );
+	FD_SET( s->ossock, &set );
+	FD_ZERO( &wakeset );
+	if ( wakeable )
+		FD_SET( s->wakesock, readset );
+	tout.tv_sec = toutUs / 1000000;
+	tout.tv_usec = toutUs % 1000000;
+
+	// first parameter is ignored by Windows, there is no limit of the socket number
+	err = select( 0, readset, forSending ? &set : NULL, NULL, &tout );
+	if ( interruptible && s->interrupted )
+		return -5;    // woken up by UDP::interrupt()
+
+	if ( err < 0 )
+		return -2;    // error
+	if ( err == 0 )
+		return -1;    // timeout
+
+	if ( wakeable && FD_ISSET( s->wakesock, readset ) )
+		return -5;    // woken up by UDP::interrupt()
+
+	return 1;  // ready
+#endif
+}
+
+
+/**
+ * \brief Internal buffers for packets received by one system call.
+ */
+struct _udp_batch_struct {
+	static const int MAX_PACKETS = 16;  // maximum number of packets per system call
+
+	int bufSize;             // size of each buffer
+	std::vector< char > data;  // buffers of all packets
+	int num;                 // number of received packets
+	int next;                // index of next packet to be returned
+#ifdef DTRACKNET_RECVMMSG
+	struct mmsghdr msgs[ MAX_PACKETS ];
+	struct iovec iovs[ MAX_PACKETS ];
+	struct sockaddr_in addrs[ MAX_PACKETS ];
+#endif
+#ifdef DTRACKNET_TIMESTAMPNS
+	union {
+		char buf[ CMSG_SPACE( sizeof( struct timespec ) ) ];
+		struct cmsghdr align;
+	} ctrls[ MAX_PACKETS ];  // control messages, containing arrival time
 #endif
 };
 
@@ -137,8 +270,12 @@ unsigned int ip_name2ip( const char* name )
  * Initialize UDP socket.
  */
 UDP::UDP( unsigned short port, unsigned int multicastIp )
-	: m_isValid( false ), m_socket( NULL ), m_port( port ), m_multicastIp( 0 ), m_remoteIp( 0 )
+	: m_isValid( false ), m_socket( NULL ), m_batch( NULL ), m_port( port ), m_multicastIp( 0 ), m_remoteIp( 0 ),
+	  m_numPackets( 0 ), m_numSyscalls( 0 ), m_isKernelTimestamp( false ), m_timestamp( 0.0 ),
+	  m_spinUs( 0 ), m_isWaited( false ), m_truncatedSize( 0 )
 {
+	resetWaitStatistics();
+
 	struct _ip_socket_struct* s;
 	struct sockaddr_in addr;
 #ifdef OS_UNIX
@@ -169,6 +306,43 @@ UDP::UDP( unsigned short port, unsigned int multicastIp )
 #endif
 	m_socket = s;
 
+	// create wakeup of waiting receive:
+#ifdef DTRACKNET_EVENTFD
+	s->wakefd_r = s->wakefd_w = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+#elif defined( OS_UNIX )
+	int wakefd[ 2 ];
+	if ( pipe( wakefd ) == 0 )
+	{
+		fcntl( wakefd[ 0 ], F_SETFL, O_NONBLOCK );
+		fcntl( wakefd[ 1 ], F_SETFL, O_NONBLOCK );
+		s->wakefd_r = wakefd[ 0 ];
+		s->wakefd_w = wakefd[ 1 ];
+	}
+#elif defined( OS_WIN )
+	// private loopback socket, so no other socket sharing the data port gets the wakeup packets
+	s->wakesock = socket( PF_INET, SOCK_DGRAM, IPPROTO_UDP );
+	if ( s->wakesock != INVALID_SOCKET )
+	{
+		BOOL flag_exclusive = TRUE;
+		u_long flag_nonblocking = 1;
+		int wakeaddrlen = sizeof( s->wakeaddr );
+
+		memset( &s->wakeaddr, 0, sizeof( s->wakeaddr ) );
+		s->wakeaddr.sin_family = AF_INET;
+		s->wakeaddr.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+		s->wakeaddr.sin_port = 0;  // chosen by the OS
+
+		if ( setsockopt( s->wakesock, SOL_SOCKET, SO_EXCLUSIVEADDRUSE, (char* )&flag_exclusive, sizeof( flag_exclusive ) ) != 0
+		     || bind( s->wakesock, (struct sockaddr* )&s->wakeaddr, sizeof( s->wakeaddr ) ) != 0
+		     || getsockname( s->wakesock, (struct sockaddr* )&s->wakeaddr, &wakeaddrlen ) != 0
+		     || ioctlsocket( s->wakesock, FIONBIO, &flag_nonblocking ) != 0 )
+		{
+			closesocket( s->wakesock );
+			s->wakesock = INVALID_SOCKET;
+		}
+	}
+#endif
+
 	if ( multicastIp != 0 )
 	{
 		// set reuse port to on to allow multiple binds per host
@@ -178,6 +352,20 @@ UDP::UDP( unsigned short port, unsigned int multicastIp )
 			perror("setsockopt() failed1");
 			return;
 		}
+#if defined( OS_UNIX ) && defined( SO_REUSEPORT )
+		// BSD/macOS share a multicast port only with this option; Linux delivers a copy of each
+		// multicast packet to every socket of the group either way (no load balancing)
+		if ( setsockopt( m_socket->ossock, SOL_SOCKET, SO_REUSEPORT, (char* )&flag_on, sizeof( flag_on ) ) < 0 )
+		{
+			perror("setsockopt() failed4");
+			return;
+		}
+#endif
+#if defined( OS_UNIX ) && defined( IP_MULTICAST_ALL )
+		// receive just the joined group, not other groups sent to the same port on this host
+		int flag_off = 0;
+		setsockopt( m_socket->ossock, IPPROTO_IP, IP_MULTICAST_ALL, (char* )&flag_off, sizeof( flag_off ) );
+#endif
 	}
 	
 	// name socket:
@@ -211,6 +399,19 @@ UDP::UDP( unsigned short port, unsigned int multicastIp )
 		}
 		m_multicastIp = multicastIp;
 	}
+
+#ifdef DTRACKNET_TIMESTAMPNS
+	// arrival time of packets taken by kernel:
+	int flag_ts = 1;
+	if ( setsockopt( m_socket->ossock, SOL_SOCKET, SO_TIMESTAMPNS, &flag_ts, sizeof( flag_ts ) ) == 0 )
+		m_isKernelTimestamp = true;
+#endif
+
+#ifdef DTRACKNET_RECVMMSG
+	m_batch = new struct _udp_batch_struct();
+	m_batch->bufSize = 0;
+	m_batch->num = m_batch->next = 0;
+#endif
 	
 	m_isValid = true;	
 }
@@ -221,6 +422,8 @@ UDP::UDP( unsigned short port, unsigned int multicastIp )
  */
 UDP::~UDP()
 {
+	delete m_batch;
+
 	if ( m_socket == NULL )  return;
 
 	if ( m_multicastIp != 0 )
@@ -237,9 +440,15 @@ UDP::~UDP()
 
 #ifdef OS_UNIX
 	close( m_socket->ossock );
+	if ( m_socket->wakefd_r >= 0 )
+		close( m_socket->wakefd_r );
+	if ( m_socket->wakefd_w >= 0 && m_socket->wakefd_w != m_socket->wakefd_r )
+		close( m_socket->wakefd_w );
 #endif
 #ifdef OS_WIN
 	closesocket( m_socket->ossock );
+	if ( m_socket->wakesock != INVALID_SOCKET )
+		closesocket( m_socket->wakesock );
 #endif
 	delete m_socket;
 }
@@ -273,31 +482,646 @@ unsigned int UDP::getRemoteIp()
 
 
 /*
- * Receive UDP data.
+ * Get number of received UDP packets.
+ */
+unsigned int UDP::getNumReceivedPackets() const
+{
+	return m_numPackets;
+}
+
+
+/*
+ * Get number of system calls needed to receive UDP packets.
+ */
+unsigned int UDP::getNumReceiveSyscalls() const
+{
+	return m_numSyscalls;
+}
+
+
+/*
+ * Get arrival time of latest received packet.
+ */
+double UDP::getReceiveTimestamp() const
+{
+	return m_timestamp;
+}
+
+
+/*
+ * Returns if arrival times are taken by the kernel.
  */
-int UDP::receive( void *buffer, int maxLen, int toutUs )
+bool UDP::isKernelTimestamp() const
+{
+	return m_isKernelTimestamp;
+}
+
+
+/*
+ * Get current system time.
+ */
+double UDP::getSystemTime()
+{
+	return std::chrono::duration< double >( std::chrono::system_clock::now().time_since_epoch() ).count();
+}
+
+
+/*
+ * Set size of receive buffer of the socket.
+ */
+int UDP::setReceiveBufferSize( int bytes )
+{
+	if ( m_socket == NULL )  return -1;
+
+	int size = bytes;
+	if ( setsockopt( m_socket->ossock, SOL_SOCKET, SO_RCVBUF, (char* )&size, sizeof( size ) ) < 0 )
+		return -1;
+
+	// read back, the OS might have changed it (e.g. Linux doubles it for internal use):
+#ifdef OS_UNIX
+	socklen_t len = sizeof( size );
+#endif
+#ifdef OS_WIN
+	int len = sizeof( size );
+#endif
+	size = 0;
+	if ( getsockopt( m_socket->ossock, SOL_SOCKET, SO_RCVBUF, (char* )&size, &len ) < 0 )
+		return -1;
+
+	return size;
+}
+
+
+/*
+ * Set busy polling of the network device while waiting for data.
+ */
+bool UDP::setBusyPoll( int us )
+{
+#if defined( OS_UNIX ) && defined( SO_BUSY_POLL )
+	if ( m_socket == NULL )  return false;
+
+	return ( setsockopt( m_socket->ossock, SOL_SOCKET, SO_BUSY_POLL, &us, sizeof( us ) ) == 0 );
+#else
+	return ( us == 0 );
+#endif
+}
+
+
+/*
+ * Set time to spin before blocking, while waiting for data.
+ */
+void UDP::setSpinTime( int us )
+{
+	m_spinUs = ( us > 0 ) ? us : 0;
+}
+
+
+/*
+ * Get statistics of waiting for data.
+ */
+WaitStatistics UDP::getWaitStatistics() const
+{
+	return m_waitStats;
+}
+
+
+/*
+ * Reset statistics of waiting for data.
+ */
+void UDP::resetWaitStatistics()
+{
+	memset( &m_waitStats, 0, sizeof( m_waitStats ) );
+}
+
+
+/*
+ * Reset numbers of received packets and system calls, and statistics of waiting for data.
+ */
+void UDP::resetStatistics()
+{
+	m_numPackets = 0;
+	m_numSyscalls = 0;
+	resetWaitStatistics();
+}
+
+
+/*
+ * Get size of latest packet, that did not fit into the buffer.
+ */
+int UDP::getTruncatedSize() const
+{
+	return m_truncatedSize;
+}
+
+
+/*
+ * Returns if the size of packets, that did not fit into the buffer, is known.
+ */
+bool UDP::isTruncatedSizeKnown()
+{
+#ifdef DTRACKNET_RECVMMSG
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+/*
+ * Returns error code after a failed receive call.
+ */
+int UDP::recvError()
+{
+#ifdef OS_WIN
+	if ( WSAGetLastError() == WSAEMSGSIZE )
+	{   // buffer overflow
+		m_numPackets++;
+		m_truncatedSize = 0;  // real size unknown
+		return -4;
+	}
+#endif
+	return -3;
+}
+
+
+/*
+ * Wait until data is available.
+ *
+ * Spins for the configured time, then blocks for the rest of the timeout.
+ */
+int UDP::waitForData( int toutUs )
 {
 	int err;
+
+	m_waitStats.numWaits++;
+
+	if ( m_spinUs > 0 && toutUs > 0 )
+	{
+		int spinUs = ( m_spinUs < toutUs ) ? m_spinUs : toutUs;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		std::chrono::steady_clock::time_point end = start + std::chrono::microseconds( spinUs );
+		std::chrono::steady_clock::time_point now;
+
+		do {
+			m_numSyscalls++;
+			err = socket_wait( m_socket, false, 0, true );
+			now = std::chrono::steady_clock::now();
+		} while ( err == -1 && now < end );
+
+		m_waitStats.spinTime += std::chrono::duration< double >( now - start ).count();
+		if ( err != -1 )
+		{
+			if ( err == 1 )
+			{
+				m_waitStats.numSpinHits++;
+				m_isWaited = true;
+			}
+			return err;
+		}
+
+		toutUs -= static_cast< int >( std::chrono::duration_cast< std::chrono::microseconds >( now - start ).count() );
+		if ( toutUs <= 0 )
+			return -1;  // timeout
+	}
+
+	m_numSyscalls++;
+	err = socket_wait( m_socket, false, toutUs, true );
+	if ( err == 1 )
+		m_isWaited = true;
+
+	return err;
+}
+
+
+/*
+ * Returns if packets are already fetched from the socket, but not yet returned.
+ */
+bool UDP::hasPendingData() const
+{
+	return ( m_batch != NULL && m_batch->next < m_batch->num );
+}
+
+
+/*
+ * Wait until data is available on at least one of several UDP sockets.
+ */
+int UDP::waitForAny( UDP* const* sockets, int num, int toutUs, bool* ready )
+{
+	int i, err;
+
+	if ( num <= 0 || num > MAX_WAIT_SOCKETS )
+		return -2;
+
+	for ( i = 0; i < num; i++ )
+	{
+		ready[ i ] = false;
+		if ( sockets[ i ]->m_socket == NULL )
+			return -2;
+
+		if ( sockets[ i ]->m_socket->interrupted )
+			return -5;
+	}
+
+#ifdef OS_UNIX
+	struct pollfd fds[ 2 * MAX_WAIT_SOCKETS ];  // sockets, then wakeups
+	int nfds = num;
+
+	for ( i = 0; i < num; i++ )
+	{
+		struct _ip_socket_struct* s = sockets[ i ]->m_socket;
+
+		fds[ i ].fd = s->ossock;
+		fds[ i ].events = POLLIN;
+		fds[ i ].revents = 0;
+		if ( s->wakefd_r >= 0 )
+		{
+			fds[ nfds ].fd = s->wakefd_r;
+			fds[ nfds ].events = POLLIN;
+			fds[ nfds ].revents = 0;
+			nfds++;
+		}
+		sockets[ i ]->m_numSyscalls++;  // shared system call, counted for each socket
+	}
+
+	do {
+		err = poll( fds, nfds, ( toutUs + 999 ) / 1000 );  // in ms, rounded up
+	} while ( err < 0 && errno == EINTR );
+
+	if ( err < 0 )
+		return -2;    // error
+	if ( err == 0 )
+		return -1;    // timeout
+
+	for ( i = num; i < nfds; i++ )
+	{
+		if ( fds[ i ].revents & POLLIN )
+			return -5;    // interrupted
+	}
+
+	err = 0;
+	for ( i = 0; i < num; i++ )
+	{
+		if ( fds[ i ].revents != 0 )  // also in case of a socket error, which is reported by the following receive
+		{
+			ready[ i ] = true;
+			sockets[ i ]->m_isWaited = true;
+			err++;
+		}
+	}
+	return err;
+#endif
+#ifdef OS_WIN
 	fd_set set;
 	struct timeval tout;
 
-	// waiting for data:
-	FD_ZERO(&set);
-	FD_SET( m_socket->ossock, &set );
+	FD_ZERO( &set );  // sockets and wakeups, up to 2 * MAX_WAIT_SOCKETS (FD_SETSIZE is 64)
+	for ( i = 0; i < num; i++ )
+	{
+		struct _ip_socket_struct* s = sockets[ i ]->m_socket;
+
+		FD_SET( s->ossock, &set );
+		if ( s->wakesock != INVALID_SOCKET )
+			FD_SET( s->wakesock, &set );
+		sockets[ i ]->m_numSyscalls++;
+	}
 	tout.tv_sec = toutUs / 1000000;
 	tout.tv_usec = toutUs % 1000000;
 
-	err = select( FD_SETSIZE, &set, NULL, NULL, &tout );
-	switch ( err )
+	// first parameter is ignored by Windows
+	err = select( 0, &set, NULL, NULL, &tout );
+
+	for ( i = 0; i < num; i++ )
 	{
-		case 1:
-			break;        // data available
-		case 0:
-			return -1;    // timeout
-		default:
-			return -2;    // error
+		struct _ip_socket_struct* s = sockets[ i ]->m_socket;
+
+		if ( s->interrupted || ( err > 0 && s->wakesock != INVALID_SOCKET && FD_ISSET( s->wakesock, &set ) ) )
+			return -5;    // woken up by interrupt()
 	}
 
+	if ( err < 0 )
+		return -2;    // error
+	if ( err == 0 )
+		return -1;    // timeout
+
+	err = 0;
+	for ( i = 0; i < num; i++ )
+	{
+		if ( FD_ISSET( sockets[ i ]->m_socket->ossock, &set ) )
+		{
+			ready[ i ] = true;
+			sockets[ i ]->m_isWaited = true;
+			err++;
+		}
+	}
+	return err;
+#endif
+}
+
+
+/*
+ * Interrupt waiting for data.
+ */
+void UDP::interrupt()
+{
+	if ( m_socket == NULL )  return;
+
+	m_socket->interrupted = true;
+
+#ifdef OS_UNIX
+	if ( m_socket->wakefd_w >= 0 )
+	{
+#ifdef DTRACKNET_EVENTFD
+		uint64_t one = 1;
+#else
+		char one = 1;
+#endif
+		if ( write( m_socket->wakefd_w, &one, sizeof( one ) ) < 0 )
+		{
+			// already signaled
+		}
+	}
+#endif
+#ifdef OS_WIN
+	// wake up select() by an empty packet of the private wakeup socket to itself:
+	if ( m_socket->wakesock != INVALID_SOCKET )
+	{
+		sendto( m_socket->wakesock, "", 0, 0, (struct sockaddr* )&m_socket->wakeaddr, (int )sizeof( m_socket->wakeaddr ) );
+	}
+#endif
+}
+
+
+/*
+ * Allow waiting for data again, after an interrupt.
+ */
+void UDP::resetInterrupt()
+{
+	if ( m_socket == NULL )  return;
+
+#ifdef OS_UNIX
+	if ( m_socket->wakefd_r >= 0 )
+	{
+#ifdef DTRACKNET_EVENTFD
+		uint64_t count;
+#else
+		char count[ 16 ];
+#endif
+		while ( read( m_socket->wakefd_r, &count, sizeof( count ) ) > 0 )
+		{
+			// drain all wakeups (non-blocking)
+		}
+	}
+#endif
+#ifdef OS_WIN
+	if ( m_socket->wakesock != INVALID_SOCKET )
+	{
+		char buf[ 16 ];
+		while ( recv( m_socket->wakesock, buf, sizeof( buf ), 0 ) >= 0 )
+		{
+			// drain all wakeups (non-blocking, empty packets)
+		}
+	}
+#endif
+
+	m_socket->interrupted = false;
+}
+
+
+/*
+ * Discard all packets, that are queued in the socket or already fetched from it.
+ */
+int UDP::discardPending()
+{
+	// limit, in case packets arrive faster than they are discarded
+	static const int MAX_DISCARD = 65536;
+
+	int num = 0;
+	char buffer[ 256 ];  // larger packets are truncated, i.e. removed as well
+
+	if ( m_socket == NULL )  return 0;
+
+	if ( m_batch != NULL )
+	{
+		num += m_batch->num - m_batch->next;
+		m_batch->num = m_batch->next = 0;
+	}
+
+	while ( num < MAX_DISCARD && socket_wait( m_socket, false, 0, false ) == 1 )
+	{
+		if ( recv( m_socket->ossock, buffer, sizeof( buffer ), 0 ) < 0 && recvError() != -4 )
+			break;  // receive error
+
+		num++;
+	}
+
+	return num;
+}
+
+
+#ifdef DTRACKNET_RECVMMSG
+/**
+ * \brief Get arrival time of a packet, taken by the kernel.
+ *
+ * @param[in] msg Header of received packet
+ * @return        Arrival time in s since 1970-01-01 (UTC), 0 if not available
+ */
+static double batch_timestamp( struct msghdr* msg )
+{
+#ifdef DTRACKNET_TIMESTAMPNS
+	for ( struct cmsghdr* cmsg = CMSG_FIRSTHDR( msg );  cmsg != NULL;  cmsg = CMSG_NXTHDR( msg, cmsg ) )
+	{
+		if ( cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS )
+		{
+			struct timespec ts;
+			memcpy( &ts, CMSG_DATA( cmsg ), sizeof( ts ) );
+			return (double )ts.tv_sec + (double )ts.tv_nsec * 1e-9;
+		}
+	}
+#else
+	(void )msg;
+#endif
+	return 0.0;
+}
+#endif
+
+
+/*
+ * Receive all available packets into the batch buffers, without waiting.
+ */
+int UDP::fetchBatch( int maxLen )
+{
+#ifdef DTRACKNET_RECVMMSG
+	struct _udp_batch_struct* b = m_batch;
+	int i, n;
+
+	if ( maxLen > b->bufSize )
+	{
+		b->bufSize = maxLen;
+		b->data.resize( (size_t )maxLen * _udp_batch_struct::MAX_PACKETS );
+	}
+
+	for ( i = 0; i < _udp_batch_struct::MAX_PACKETS; i++ )
+	{
+		b->iovs[ i ].iov_base = &b->data[ (size_t )i * b->bufSize ];
+		b->iovs[ i ].iov_len = b->bufSize;
+
+		memset( &b->msgs[ i ].msg_hdr, 0, sizeof( b->msgs[ i ].msg_hdr ) );
+		b->msgs[ i ].msg_hdr.msg_iov = &b->iovs[ i ];
+		b->msgs[ i ].msg_hdr.msg_iovlen = 1;
+		b->msgs[ i ].msg_hdr.msg_name = &b->addrs[ i ];
+		b->msgs[ i ].msg_hdr.msg_namelen = sizeof( struct sockaddr_in );
+#ifdef DTRACKNET_TIMESTAMPNS
+		if ( m_isKernelTimestamp )
+		{
+			b->msgs[ i ].msg_hdr.msg_control = b->ctrls[ i ].buf;
+			b->msgs[ i ].msg_hdr.msg_controllen = sizeof( b->ctrls[ i ].buf );
+		}
+#endif
+		b->msgs[ i ].msg_len = 0;
+	}
+
+	b->num = b->next = 0;
+
+	m_numSyscalls++;
+	n = recvmmsg( m_socket->ossock, b->msgs, _udp_batch_struct::MAX_PACKETS, MSG_DONTWAIT | MSG_TRUNC, NULL );  // real length of truncated packets
+	if ( n < 0 )
+	{
+		if ( errno == EAGAIN || errno == EWOULDBLOCK )
+			return 0;  // no data available
+
+		return -3;
+	}
+
+	b->num = n;
+	m_numPackets += n;
+	m_timestamp = getSystemTime();  // if no kernel timestamp
+
+	if ( m_isWaited && n > 0 )
+	{
+		// wake-up latency: arrival of oldest packet until fetched
+		double arrival = batch_timestamp( &b->msgs[ 0 ].msg_hdr );
+		if ( arrival > 0.0 )
+		{
+			double latency = m_timestamp - arrival;
+			if ( latency < 0.0 )  latency = 0.0;
+
+			m_waitStats.numLatencies++;
+			m_waitStats.sumLatency += latency;
+			if ( latency > m_waitStats.maxLatency )
+				m_waitStats.maxLatency = latency;
+		}
+	}
+	m_isWaited = false;
+
+	return n;
+#else
+	(void )maxLen;
+	return -3;
+#endif
+}
+
+
+/*
+ * Get next packet of the batch buffers.
+ */
+int UDP::popBatch( void *buffer, int maxLen )
+{
+#ifdef DTRACKNET_RECVMMSG
+	struct _udp_batch_struct* b = m_batch;
+	int i = b->next++;
+	int nbytes = static_cast< int >( b->msgs[ i ].msg_len );
+
+	if ( b->addrs[ i ].sin_family == AF_INET )  // only IPv4 supported
+	{
+		m_remoteIp = ntohl( b->addrs[ i ].sin_addr.s_addr );
+	}
+
+	double arrival = batch_timestamp( &b->msgs[ i ].msg_hdr );
+	if ( arrival > 0.0 )
+		m_timestamp = arrival;
+
+	if ( nbytes >= maxLen || ( b->msgs[ i ].msg_hdr.msg_flags & MSG_TRUNC ) )
+	{   // buffer overflow; real size is known due to MSG_TRUNC
+		m_truncatedSize = nbytes;
+		return -4;
+	}
+
+	memcpy( buffer, &b->data[ (size_t )i * b->bufSize ], nbytes );
+	return nbytes;
+#else
+	(void )buffer;
+	(void )maxLen;
+	return -3;
+#endif
+}
+
+
+/*
+ * Receive UDP data.
+ */
+int UDP::receive( void *buffer, int maxLen, int toutUs, unsigned int* numDropped )
+{
+	int err;
+
+	if ( m_batch != NULL )
+	{
+		// several packets per system call:
+		int nbytes = -1;
+		bool isReceived = false;
+
+		if ( m_batch->next >= m_batch->num )
+		{
+			std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + std::chrono::microseconds( toutUs );
+
+			while ( true )
+			{
+				err = waitForData( toutUs );
+				if ( err < 0 )
+					return err;
+
+				err = fetchBatch( maxLen );
+				if ( err < 0 )
+					return -3;
+
+				if ( err > 0 )
+					break;
+
+				// readable, but no packet (e.g. dropped by the kernel due to a wrong checksum): wait for the rest of the timeout
+				toutUs = static_cast< int >( std::chrono::duration_cast< std::chrono::microseconds >( end - std::chrono::steady_clock::now() ).count() );
+				if ( toutUs <= 0 )
+					return -1;  // timeout
+			}
+		}
+
+		while ( true )
+		{
+			int pending = m_batch->num - m_batch->next;
+			if ( pending > 0 )
+			{
+				// keep just the newest packet:
+				if ( numDropped != NULL )
+					*numDropped += pending - 1 + ( isReceived ? 1 : 0 );
+
+				m_batch->next = m_batch->num - 1;
+				nbytes = popBatch( buffer, maxLen );
+				isReceived = true;
+			}
+
+			if ( m_batch->num < _udp_batch_struct::MAX_PACKETS )
+				break;  // no more data available
+
+			if ( fetchBatch( maxLen ) <= 0 )
+				break;
+		}
+
+		return nbytes;
+	}
+
+	// waiting for data:
+	err = waitForData( toutUs );
+	if ( err < 0 )
+		return err;
+
 	// receiving packet:
 	while ( true )
 	{
@@ -310,12 +1134,15 @@ int UDP::receive( void *buffer, int maxLen, int toutUs )
 #endif
 		addrlen = sizeof( struct sockaddr_in );
 
+		m_numSyscalls++;
 		int nbytes = static_cast< int >( recvfrom( m_socket->ossock, ( char* )buffer, maxLen, 0,
 		                                           ( struct sockaddr* )&addr, &addrlen ) );  // receive one packet
 		if (nbytes < 0)
 		{	// receive error
-			return -3;
+			return recvError();
 		}
+		m_numPackets++;
+		m_timestamp = getSystemTime();
 
 		if ( addr.sin_family == AF_INET )  // only IPv4 supported
 		{
@@ -323,31 +1150,98 @@ int UDP::receive( void *buffer, int maxLen, int toutUs )
 		}
 
 		// check, if more data available: if so, receive another packet
-		FD_ZERO(&set);
-		FD_SET( m_socket->ossock, &set );
-
-		tout.tv_sec = 0;   // no timeout
-		tout.tv_usec = 0;
-		if (select(FD_SETSIZE, &set, NULL, NULL, &tout) != 1)
+		m_numSyscalls++;
+		if ( socket_wait( m_socket, false, 0, false ) != 1 )
 		{
 			// no more data available: check length of received packet and return
 			if ( nbytes >= maxLen )
 			{   // buffer overflow
+				m_truncatedSize = 0;  // real size unknown
 				return -4;
 			}
 			return nbytes;
 		}
+
+		if ( numDropped != NULL )
+			( *numDropped )++;  // packet is overwritten by next one
 	}
 }
 
 
+/*
+ * Receive next UDP packet.
+ */
+int UDP::receiveNext( void *buffer, int maxLen, int toutUs )
+{
+	int err;
+	struct sockaddr_in addr;
+#ifdef OS_UNIX
+	socklen_t addrlen;
+#endif
+#ifdef OS_WIN
+	int addrlen;
+#endif
+
+	if ( m_batch != NULL )
+	{
+		// several packets per system call:
+		if ( m_batch->next >= m_batch->num )
+		{
+			if ( toutUs > 0 )
+			{
+				err = waitForData( toutUs );
+				if ( err < 0 )
+					return err;
+			}
+
+			err = fetchBatch( maxLen );
+			if ( err == 0 )
+				return -1;  // no data available
+
+			if ( err < 0 )
+				return -3;
+		}
+
+		return popBatch( buffer, maxLen );
+	}
+
+	// waiting for data:
+	err = waitForData( toutUs );
+	if ( err < 0 )
+		return err;
+
+	// receiving packet:
+	addrlen = sizeof( struct sockaddr_in );
+
+	m_numSyscalls++;
+	int nbytes = static_cast< int >( recvfrom( m_socket->ossock, ( char* )buffer, maxLen, 0,
+	                                           ( struct sockaddr* )&addr, &addrlen ) );  // receive one packet
+	if (nbytes < 0)
+	{	// receive error
+		return recvError();
+	}
+	m_numPackets++;
+	m_timestamp = getSystemTime();
+
+	if ( addr.sin_family == AF_INET )  // only IPv4 supported
+	{
+		m_remoteIp = ntohl( addr.sin_addr.s_addr );
+	}
+
+	if ( nbytes >= maxLen )
+	{   // buffer overflow
+		m_truncatedSize = 0;  // real size unknown
+		return -4;
+	}
+	return nbytes;
+}
+
+
 /*
  * Send UDP data.
  */
 int UDP::send( const void* buffer, int len, unsigned int ip, unsigned short port, int toutUs )
 {
-	fd_set set;
-	struct timeval tout;
 	int err;
 	struct sockaddr_in addr;
 
@@ -357,21 +1251,9 @@ int UDP::send( const void* buffer, int len, unsigned int ip, unsigned short port
 	addr.sin_port = htons(port);
 
 	// waiting to send data:
-	FD_ZERO(&set);
-	FD_SET( m_socket->ossock, &set );
-	tout.tv_sec = toutUs / 1000000;
-	tout.tv_usec = toutUs % 1000000;
-
-	err = select( FD_SETSIZE, NULL, &set, NULL, &tout );
-	switch ( err )
-	{
-		case 1:
-			break;
-		case 0:
-			return -1;    // timeout
-		default:
-			return -2;    // error
-	}
+	err = socket_wait( m_socket, true, toutUs, false );
+	if ( err < 0 )
+		return err;
 
 	// sending data:
 	int nbytes = static_cast< int >( sendto( m_socket->ossock, (const char* )buffer, len, 0, (struct sockaddr* )&addr,
@@ -461,25 +1343,11 @@ bool TCP::isValid()
 int TCP::receive( void *buffer, int maxLen, int toutUs )
 {
 	int err;
-	fd_set set;
-	struct timeval tout;
 
 	// waiting for data:
-	FD_ZERO(&set);
-	FD_SET( m_socket->ossock, &set );
-	tout.tv_sec = toutUs / 1000000;
-	tout.tv_usec = toutUs % 1000000;
-
-	err = select( FD_SETSIZE, &set, NULL, NULL, &tout );
-	switch ( err )
-	{
-		case 1:
-			break;        // data available
-		case 0:
-			return -1;    // timeout
-		default:
-			return -2;    // error
-	}
+	err = socket_wait( m_socket, false, toutUs, false );
+	if ( err < 0 )
+		return err;
 
 	// receiving packet:
 	int nbytes = static_cast< int >( recv( m_socket->ossock, (char *)buffer, maxLen, 0 ) );
@@ -504,26 +1372,12 @@ int TCP::receive( void *buffer, int maxLen, int toutUs )
  */
 int TCP::send( const void* buffer, int len, int toutUs )
 {
-	fd_set set;
-	struct timeval tout;
 	int err;
 
 	// waiting to send data:
-	FD_ZERO(&set);
-	FD_SET( m_socket->ossock, &set );
-	tout.tv_sec = toutUs / 1000000;
-	tout.tv_usec = toutUs % 1000000;
-
-	err = select( FD_SETSIZE, NULL, &set, NULL, &tout );
-	switch ( err )
-	{
-		case 1:
-			break;
-		case 0:
-			return -1;    // timeout
-		default:
-			return -2;    // error
-	}
+	err = socket_wait( m_socket, true, toutUs, false );
+	if ( err < 0 )
+		return err;
 
 	// sending data:
 	int nbytes = static_cast< int >( sendto( m_socket->ossock, (const char* )buffer, len, 0, NULL, 0 ) );
@@ -34,9 +34,12 @@
 #ifndef _ART_DTRACKNET_H_
 #define _ART_DTRACKNET_H_
 
+#include <cstddef>
+
 namespace DTrackNet {
 
 struct _ip_socket_struct;  // forward declaration
+struct _udp_batch_struct;  // forward declaration
 
 /**
  * \brief Initialize network ressources.
@@ -58,6 +61,21 @@ void net_exit(void);
 unsigned int ip_name2ip(const char* name);
 
 
+/**
+ * \brief Statistics of waiting for UDP data.
+ */
+struct WaitStatistics
+{
+	unsigned int numWaits;      //!< number of waits for data
+	unsigned int numSpinHits;   //!< number of waits, that got data while spinning
+	double spinTime;            //!< time spent spinning (CPU cost) in s
+
+	unsigned int numLatencies;  //!< number of measured wake-up latencies (needs kernel timestamps)
+	double sumLatency;          //!< sum of wake-up latencies (packet arrival until fetched) in s
+	double maxLatency;          //!< maximum wake-up latency in s
+};
+
+
 /**
  * \brief Handling UDP data.
  */
@@ -102,14 +120,176 @@ public:
 	/**
 	 * \brief Receive UDP data.
 	 *
-	 * Tries to receive one packet, as long as data is available.
+	 * Tries to receive one packet, as long as data is available. Just the newest packet is kept.
+	 *
+	 * @param[out]    buffer     Buffer for UDP data
+	 * @param[in]     maxLen     Length of buffer
+	 * @param[in]     toutUs     Timeout in us (micro seconds)
+	 * @param[in,out] numDropped Incremented by number of older packets, that were dropped (optional)
+	 * @return                   Number of received bytes, <0 if error/timeout occured, -4 buffer too small
+	 *                           (see getTruncatedSize()), -5 interrupted
+	 */
+	int receive( void *buffer, int maxLen, int toutUs, unsigned int* numDropped = NULL );
+
+	/**
+	 * \brief Receive next UDP packet.
+	 *
+	 * Receives the oldest available packet, further ones stay queued.
 	 *
 	 * @param[out] buffer Buffer for UDP data
 	 * @param[in]  maxLen Length of buffer
-	 * @param[in]  toutUs Timeout in us (micro seconds)
-	 * @return            Number of received bytes, <0 if error/timeout occured
+	 * @param[in]  toutUs Timeout in us (micro seconds); 0 to just check for available data
+	 * @return            Number of received bytes, <0 if error/timeout occured, -4 buffer too small
+	 *                    (see getTruncatedSize()), -5 interrupted
 	 */
-	int receive( void *buffer, int maxLen, int toutUs );
+	int receiveNext( void *buffer, int maxLen, int toutUs );
+
+	/**
+	 * \brief Get number of received UDP packets.
+	 *
+	 * @return Number of packets, including dropped ones
+	 */
+	unsigned int getNumReceivedPackets() const;
+
+	/**
+	 * \brief Get number of system calls needed to receive UDP packets.
+	 *
+	 * Several packets per system call are received, if supported by the OS (Linux).
+	 *
+	 * @return Number of system calls
+	 */
+	unsigned int getNumReceiveSyscalls() const;
+
+	/**
+	 * \brief Get arrival time of latest received packet.
+	 *
+	 * Taken by the kernel when the packet arrived, if supported (Linux). Otherwise taken when the
+	 * packet was fetched from the socket.
+	 *
+	 * @return Arrival time in s since 1970-01-01 (UTC), same clock as getSystemTime(); 0 if nothing received yet
+	 */
+	double getReceiveTimestamp() const;
+
+	/**
+	 * \brief Returns if arrival times are taken by the kernel.
+	 *
+	 * @return Kernel timestamps enabled?
+	 */
+	bool isKernelTimestamp() const;
+
+	/**
+	 * \brief Get current system time.
+	 *
+	 * @return Time in s since 1970-01-01 (UTC)
+	 */
+	static double getSystemTime();
+
+	/**
+	 * \brief Get size of latest packet, that did not fit into the buffer (i.e. receive returned -4).
+	 *
+	 * @return Size in bytes, 0 if unknown (known on Linux only)
+	 */
+	int getTruncatedSize() const;
+
+	/**
+	 * \brief Returns if the size of packets, that did not fit into the buffer, is known (see getTruncatedSize()).
+	 *
+	 * @return Size is known (Linux only)
+	 */
+	static bool isTruncatedSizeKnown();
+
+	/**
+	 * \brief Set size of receive buffer of the socket (SO_RCVBUF).
+	 *
+	 * @param[in] bytes Requested size in bytes
+	 * @return          Actual size in bytes (might differ, depending on the OS), <0 if error occured
+	 */
+	int setReceiveBufferSize( int bytes );
+
+	/**
+	 * \brief Set busy polling of the network device while waiting for data (SO_BUSY_POLL, Linux only).
+	 *
+	 * Raising the value above the system default might need additional privileges.
+	 *
+	 * @param[in] us Busy polling time in us (micro seconds), 0 to disable
+	 * @return       Setting succeeded?
+	 */
+	bool setBusyPoll( int us );
+
+	/**
+	 * \brief Set time to spin before blocking, while waiting for data.
+	 *
+	 * Spinning checks for data without sleeping, saving the wake-up latency of the OS at the cost of CPU time.
+	 *
+	 * @param[in] us Spinning time in us (micro seconds), 0 to block at once
+	 */
+	void setSpinTime( int us );
+
+	/**
+	 * \brief Get statistics of waiting for data.
+	 *
+	 * @return Statistics
+	 */
+	WaitStatistics getWaitStatistics() const;
+
+	/**
+	 * \brief Reset statistics of waiting for data.
+	 */
+	void resetWaitStatistics();
+
+	/**
+	 * \brief Reset numbers of received packets and system calls, and statistics of waiting for data.
+	 */
+	void resetStatistics();
+
+	/**
+	 * \brief Interrupt waiting for data.
+	 *
+	 * Wakes up a receive, that is waiting in another thread, immediately. All following receives return
+	 * at once as interrupted. Can be called from any thread.
+	 */
+	void interrupt();
+
+	/**
+	 * \brief Allow waiting for data again, after an interrupt.
+	 *
+	 * Must not be called while another thread is waiting for data of this socket.
+	 */
+	void resetInterrupt();
+
+	/**
+	 * \brief Discard all packets, that are queued in the socket or already fetched from it.
+	 *
+	 * Must not be called while another thread is waiting for data of this socket.
+	 *
+	 * @return Number of discarded packets
+	 */
+	int discardPending();
+
+	/**
+	 * \brief Returns if packets are already fetched from the socket, but not yet returned by receive.
+	 *
+	 * Such packets are not signaled by waitForAny().
+	 *
+	 * @return Packets pending?
+	 */
+	bool hasPendingData() const;
+
+	static const int MAX_WAIT_SOCKETS = 32;  //!< maximum number of sockets for waitForAny()
+
+	/**
+	 * \brief Wait until data is available on at least one of several UDP sockets.
+	 *
+	 * Waits with one system call for all sockets. Returns at once, if one of the sockets was interrupted
+	 * (see interrupt()).
+	 *
+	 * @param[in]  sockets UDP sockets (maximum MAX_WAIT_SOCKETS)
+	 * @param[in]  num     Number of sockets
+	 * @param[in]  toutUs  Timeout in us (micro seconds)
+	 * @param[out] ready   Data available, per socket
+	 * @return             Number of sockets with data available, -1 timeout, -2 error, -5 interrupted
+	 */
+	static int waitForAny( UDP* const* sockets, int num, int toutUs, bool* ready );
 
 	/**
  	* \brief Send UDP data.
@@ -125,11 +305,52 @@ public:
 
 private:
 
+	/**
+	 * \brief Wait until data is available.
+	 *
+	 * @param[in] toutUs Timeout in us (micro seconds)
+	 * @return           1 if data available, -1 timeout, -2 error, -5 interrupted
+	 */
+	int waitForData( int toutUs );
+
+	/**
+	 * \brief Receive all available packets into the batch buffers, without waiting (Linux only).
+	 *
+	 * @param[in] maxLen Minimum length of each buffer
+	 * @return           Number of received packets, <0 if error occured
+	 */
+	int fetchBatch( int maxLen );
+
+	/**
+	 * \brief Get next packet of the batch buffers (Linux only).
+	 *
+	 * @param[out] buffer Buffer for UDP data
+	 * @param[in]  maxLen Length of buffer
+	 * @return            Number of bytes, <0 if error occured
+	 */
+	int popBatch( void *buffer, int maxLen );
+
+	/**
+	 * \brief Returns error code after a failed receive call.
+	 *
+	 * @return -4 if buffer was too small, -3 else
+	 */
+	int recvError();
+
 	bool m_isValid;
 	struct _ip_socket_struct* m_socket;
+	struct _udp_batch_struct* m_batch;  // packets received by one system call (NULL if not supported)
 	unsigned short m_port;
 	unsigned int m_multicastIp;
 	unsigned int m_remoteIp;
+	unsigned int m_numPackets;
+	unsigned int m_numSyscalls;
+	bool m_isKernelTimestamp;
+	double m_timestamp;  // arrival time of latest packet
+	int m_spinUs;        // time to spin before blocking
+	bool m_isWaited;     // data of next fetch was waited for, i.e. wake-up latency can be measured
+	WaitStatistics m_waitStats;
+	int m_truncatedSize;  // size of latest packet, that did not fit into the buffer
 };
 
 
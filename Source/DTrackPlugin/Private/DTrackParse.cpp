@@ -37,6 +37,22 @@
 #include <cstring>
 #include <cstdlib>
 
+// vectorized line search, if available:
+#if defined( __AVX2__ )
+	#include <immintrin.h>
+	#define DTRACKPARSE_AVX2
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || defined( _M_AMD64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+	#include <emmintrin.h>
+	#define DTRACKPARSE_SSE2
+#elif ( defined( __ARM_NEON ) && defined( __aarch64__ ) ) || defined( _M_ARM64 )
+	#include <arm_neon.h>
+	#define DTRACKPARSE_NEON
+#endif
+
+#if defined( _MSC_VER ) && ( defined( DTRACKPARSE_AVX2 ) || defined( DTRACKPARSE_SSE2 ) )
+	#include <intrin.h>
+#endif
+
 namespace DTrackSDK_Parse {
 
 /**
@@ -68,6 +84,484 @@ char* string_nextline(char* str, char* start, int len)
 }
 
 
+/**
+ *	\brief	Search next line in buffer (non-mutating, length-bounded)
+ *	@param[in] 	start	start position within buffer
+ *	@param[in] 	end		end of buffer (behind last character)
+ *	@return		begin of line, NULL if no new line in buffer
+ */
+const char* string_nextline(const char* start, const char* end)
+{
+	const char* s = start;
+	bool crlffound = false;
+	while (s < end)
+	{
+		if (*s == '\r' || *s == '\n')
+		{	// crlf
+			crlffound = true;
+		} else {
+			if(crlffound)
+			{	// begin of new line found
+				return s;
+			}
+		}
+		s++;
+	}
+	return NULL;	// no new line found in buffer
+}
+
+
+#if defined( DTRACKPARSE_AVX2 ) || defined( DTRACKPARSE_SSE2 )
+
+/**
+ * 	\brief	Index of lowest set bit (mask must not be 0)
+ */
+static inline int parse_lowest_bit(unsigned int mask)
+{
+#if defined( _MSC_VER )
+	unsigned long index;
+	_BitScanForward( &index, mask );
+	return (int )index;
+#else
+	return __builtin_ctz( mask );
+#endif
+}
+
+
+/**
+ * 	\brief	Add line begins found in a block of characters to the line index
+ *
+ *	@param[in] 		crlf		bit mask of CR/LF characters within block
+ *	@param[in] 		nbits		size of block
+ *	@param[in] 		offset		offset of block relative to begin of buffer
+ *	@param[in,out] 	prevcrlf	last character of previous block was CR/LF?
+ *	@param[out] 	offsets		offsets of line begins
+ */
+static inline void parse_add_line_begins(unsigned int crlf, int nbits, int offset, bool& prevcrlf, std::vector< int >& offsets)
+{
+	unsigned int begins = ~crlf & ( ( crlf << 1 ) | ( prevcrlf ? 1u : 0u ) );
+	if ( nbits < 32 )
+		begins &= ( 1u << nbits ) - 1u;
+
+	while ( begins != 0 )
+	{
+		offsets.push_back( offset + parse_lowest_bit( begins ) );
+		begins &= begins - 1;
+	}
+	prevcrlf = ( ( crlf >> ( nbits - 1 ) ) & 1u ) != 0;
+}
+
+#endif
+
+
+/**
+ *	\brief	Find begin of all lines in buffer, in one pass (vectorized if SSE2/AVX2/NEON is available)
+ *	@param[in] 	str		begin of buffer
+ *	@param[in] 	end		end of buffer (behind last character)
+ *	@param[out] offsets	offsets of all line begins relative to str
+ *	@return		number of lines
+ */
+int string_index_lines(const char* str, const char* end, std::vector< int >& offsets)
+{
+	const char* s = str;
+	bool prevcrlf = false;
+
+	offsets.clear();
+	if ( str >= end )
+		return 0;
+
+	offsets.push_back( 0 );
+
+#if defined( DTRACKPARSE_AVX2 )
+	const __m256i cr32 = _mm256_set1_epi8( '\r' );
+	const __m256i lf32 = _mm256_set1_epi8( '\n' );
+	while ( end - s >= 32 )
+	{
+		__m256i v = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( s ) );
+		unsigned int crlf = (unsigned int )_mm256_movemask_epi8(
+		                        _mm256_or_si256( _mm256_cmpeq_epi8( v, cr32 ), _mm256_cmpeq_epi8( v, lf32 ) ) );
+		if ( crlf != 0 || prevcrlf )
+		{
+			parse_add_line_begins( crlf, 32, (int )( s - str ), prevcrlf, offsets );
+		}
+		s += 32;
+	}
+#endif
+
+#if defined( DTRACKPARSE_AVX2 ) || defined( DTRACKPARSE_SSE2 )
+	const __m128i cr16 = _mm_set1_epi8( '\r' );
+	const __m128i lf16 = _mm_set1_epi8( '\n' );
+	while ( end - s >= 16 )
+	{
+		__m128i v = _mm_loadu_si128( reinterpret_cast< const __m128i* >( s ) );
+		unsigned int crlf = (unsigned int )_mm_movemask_epi8( _mm_or_si128( _mm_cmpeq_epi8( v, cr16 ), _mm_cmpeq_epi8( v, lf16 ) ) );
+		if ( crlf != 0 || prevcrlf )
+		{
+			parse_add_line_begins( crlf, 16, (int )( s - str ), prevcrlf, offsets );
+		}
+		s += 16;
+	}
+#endif
+
+#if defined( DTRACKPARSE_NEON )
+	const uint8x16_t cr16 = vdupq_n_u8( '\r' );
+	const uint8x16_t lf16 = vdupq_n_u8( '\n' );
+	while ( end - s >= 16 )
+	{
+		uint8x16_t v = vld1q_u8( reinterpret_cast< const uint8_t* >( s ) );
+		if ( vmaxvq_u8( vorrq_u8( vceqq_u8( v, cr16 ), vceqq_u8( v, lf16 ) ) ) != 0 || prevcrlf )
+		{	// CR/LF inside block: process bytewise
+			for ( int i = 0; i < 16; i++ )
+			{
+				bool crlf = ( s[ i ] == '\r' || s[ i ] == '\n' );
+				if ( ! crlf && prevcrlf )
+					offsets.push_back( (int )( s - str ) + i );
+				prevcrlf = crlf;
+			}
+		}
+		s += 16;
+	}
+#endif
+
+	// remaining characters:
+	while ( s < end )
+	{
+		bool crlf = ( *s == '\r' || *s == '\n' );
+		if ( ! crlf && prevcrlf )
+			offsets.push_back( (int )( s - str ) );
+		prevcrlf = crlf;
+		s++;
+	}
+
+	return (int )offsets.size();
+}
+
+
+/**
+ * 	\brief	Search character in string
+ *	@param[in] 	str		string
+ *	@param[in] 	end		end of string (behind last character); NULL if string is terminated by '\0'
+ *	@param[in] 	c		character
+ *	@return		position of character, NULL if not found
+ */
+static inline const char* string_find(const char* str, const char* end, char c)
+{
+	if ( end == NULL )
+		return strchr( str, c );
+
+	if ( str >= end )
+		return NULL;
+
+	return static_cast< const char* >( memchr( str, c, end - str ) );
+}
+
+
+// max. number of decimal digits, that can be stored exactly in the mantissa of a 'double' value
+static const int PARSE_MAX_DIGITS = 19;
+
+// powers of ten, that can be represented exactly as 'double' value
+static const double PARSE_POW10[] = {
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+static const int PARSE_MAX_POW10 = 22;
+
+
+/**
+ * 	\brief	Check for white space (like isspace() in "C" locale)
+ */
+static inline bool parse_is_space(char c)
+{
+	return ( c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r' );
+}
+
+
+/**
+ * 	\brief	Check for decimal digit
+ */
+static inline bool parse_is_digit(char c)
+{
+	return ( c >= '0' && c <= '9' );
+}
+
+
+/**
+ * 	\brief	Skip leading white spaces
+ */
+static inline const char* parse_skip_space(const char* s, const char* last)
+{
+	while ( s != last && parse_is_space( *s ) )
+	{
+		s++;
+	}
+	return s;
+}
+
+
+// max. length of a number, that is processed by the standard library (including terminating '\0')
+static const int PARSE_MAX_NUMBER_LEN = 64;
+
+
+/**
+ * 	\brief	Copy number into a '\0' terminated buffer, to be processed by the standard library
+ *
+ *	The number ends at the first white space, ']' or '\0'. A number that doesn't fit completely
+ *	into the buffer is not copied at all, so parsing never resumes in the middle of a number.
+ *
+ *	@param[in] 	first	begin of number (without leading white spaces)
+ *	@param[in] 	last	end of string; NULL if string is terminated by '\0'
+ *	@param[out] buf		buffer
+ *	@param[in] 	len		buffer length in bytes
+ *	@param[in] 	dp		character to be used as decimal point
+ *	@return		number was copied; false if it is too long for the buffer
+ */
+static bool parse_copy_number(const char* first, const char* last, char* buf, int len, char dp)
+{
+	int n = 0;
+	while ( ( first != last ) && ( *first != '\0' ) && ( *first != ']' ) && ! parse_is_space( *first ) )
+	{
+		if ( n >= len - 1 )
+		{
+			buf[ 0 ] = '\0';
+			return false;
+		}
+
+		buf[ n++ ] = ( *first == '.' ) ? dp : *first;
+		first++;
+	}
+	buf[ n ] = '\0';
+	return true;
+}
+
+
+/**
+ * 	\brief	Get decimal point of the current locale, as used by strtod()
+ *
+ *	Uses snprintf() instead of localeconv(), as the latter is not thread-safe.
+ */
+static char parse_locale_decimal_point()
+{
+	char buf[ 8 ];
+
+	if ( snprintf( buf, sizeof( buf ), "%.1f", 0.5 ) != 3 )  // e.g. "0,5"
+		return '.';
+
+	return buf[ 1 ];
+}
+
+
+/**
+ * 	\brief	Fallback for 'double' values not covered by the fast path (very long mantissa, large exponents, ...)
+ *
+ *	Replaces the decimal point by the one of the current locale, so the locale of the process
+ *	does not need to be changed. Numbers with more than 63 characters are rejected.
+ */
+static const char* parse_d_fallback(const char* first, const char* last, double* d)
+{
+	char buf[ PARSE_MAX_NUMBER_LEN ];
+	char* s;
+
+	if ( ! parse_copy_number( first, last, buf, sizeof( buf ), parse_locale_decimal_point() ) )
+		return NULL;
+
+	*d = strtod( buf, &s );
+	return ( s == buf ) ? NULL : first + ( s - buf );
+}
+
+
+/*
+ * Parse 'int' value (DTrack number format, independent of locale).
+ */
+const char* string_parse_i(const char* first, const char* last, int* i)
+{
+	const char* s = parse_skip_space( first, last );
+	const char* sb = s;
+	const char* sd;
+	bool neg = false;
+	int n = 0;
+	long v = 0;
+
+	if ( s != last && ( *s == '-' || *s == '+' ) )
+	{
+		neg = ( *s == '-' );
+		s++;
+	}
+
+	sd = s;
+	while ( s != last && parse_is_digit( *s ) && n < 9 )
+	{
+		v = v * 10 + ( *s - '0' );
+		s++;
+		n++;
+	}
+
+	if ( n == 0 || ( n > 1 && *sd == '0' ) || ( s != last && ( parse_is_digit( *s ) || *s == 'x' || *s == 'X' ) ) )
+	{	// no simple decimal number: octal, hexadecimal, long or invalid
+		char buf[ PARSE_MAX_NUMBER_LEN ];
+		char* se;
+
+		if ( ! parse_copy_number( sb, last, buf, sizeof( buf ), '.' ) )
+			return NULL;
+
+		*i = (int )strtol( buf, &se, 0 );
+		return ( se == buf ) ? NULL : sb + ( se - buf );
+	}
+
+	*i = (int )( neg ? -v : v );
+	return s;
+}
+
+
+/*
+ * Parse 'unsigned int' value (DTrack number format, independent of locale).
+ */
+const char* string_parse_ui(const char* first, const char* last, unsigned int* ui)
+{
+	const char* s = parse_skip_space( first, last );
+	const char* sb = s;
+	int n = 0;
+	unsigned long v = 0;
+
+	while ( s != last && parse_is_digit( *s ) && n < 9 )
+	{
+		v = v * 10 + ( *s - '0' );
+		s++;
+		n++;
+	}
+
+	if ( n == 0 || ( n > 1 && *sb == '0' ) || ( s != last && ( parse_is_digit( *s ) || *s == 'x' || *s == 'X' ) ) )
+	{	// no simple decimal number: signed, octal, hexadecimal, long or invalid
+		char buf[ PARSE_MAX_NUMBER_LEN ];
+		char* se;
+
+		if ( ! parse_copy_number( sb, last, buf, sizeof( buf ), '.' ) )
+			return NULL;
+
+		*ui = (unsigned int )strtoul( buf, &se, 0 );
+		return ( se == buf ) ? NULL : sb + ( se - buf );
+	}
+
+	*ui = (unsigned int )v;
+	return s;
+}
+
+
+/*
+ * Parse 'double' value (DTrack number format, independent of locale).
+ *
+ * Fast path: as long as mantissa and power of ten are exactly representable, one multiplication
+ * or division gives the correctly rounded result (i.e. identical to strtod()).
+ */
+const char* string_parse_d(const char* first, const char* last, double* d)
+{
+	const char* s = parse_skip_space( first, last );
+	const char* sb = s;
+	bool neg = false;
+	unsigned long long mant = 0;
+	int ndigits = 0;     // number of significant digits in mantissa
+	int nread = 0;       // number of digits read at all
+	int exp10 = 0;
+	bool exact = true;
+
+	if ( s != last && ( *s == '-' || *s == '+' ) )
+	{
+		neg = ( *s == '-' );
+		s++;
+	}
+
+	// integer part:
+	while ( s != last && parse_is_digit( *s ) )
+	{
+		if ( ndigits < PARSE_MAX_DIGITS )
+		{
+			mant = mant * 10 + ( *s - '0' );
+			if ( mant != 0 )  ndigits++;
+		}
+		else
+		{
+			exact = false;
+		}
+		s++;
+		nread++;
+	}
+
+	// fractional part:
+	if ( s != last && *s == '.' )
+	{
+		s++;
+		while ( s != last && parse_is_digit( *s ) )
+		{
+			if ( ndigits < PARSE_MAX_DIGITS )
+			{
+				mant = mant * 10 + ( *s - '0' );
+				if ( mant != 0 )  ndigits++;
+				exp10--;
+			}
+			else
+			{
+				exact = false;
+			}
+			s++;
+			nread++;
+		}
+	}
+
+	if ( nread == 0 || ! exact || ( s != last && ( *s == 'x' || *s == 'X' ) ) )
+	{	// no digits (e.g. 'inf', 'nan' or invalid), hexadecimal or too many digits
+		return parse_d_fallback( sb, last, d );
+	}
+
+	// exponent (only consumed if followed by digits, like strtod()):
+	if ( s != last && ( *s == 'e' || *s == 'E' ) )
+	{
+		const char* se = s + 1;
+		bool eneg = false;
+		int e = 0;
+
+		if ( se != last && ( *se == '-' || *se == '+' ) )
+		{
+			eneg = ( *se == '-' );
+			se++;
+		}
+
+		if ( se != last && parse_is_digit( *se ) )
+		{
+			while ( se != last && parse_is_digit( *se ) )
+			{
+				if ( e < 10000 )  e = e * 10 + ( *se - '0' );
+				se++;
+			}
+			exp10 += eneg ? -e : e;
+			s = se;
+		}
+	}
+
+	if ( mant == 0 )
+	{
+		*d = neg ? -0.0 : 0.0;
+		return s;
+	}
+
+	if ( mant > ( 1ULL << 53 ) || exp10 < -PARSE_MAX_POW10 || exp10 > PARSE_MAX_POW10 )
+	{	// not exactly representable
+		return parse_d_fallback( sb, last, d );
+	}
+
+	double v = static_cast< double >( mant );
+	if ( exp10 < 0 )
+	{
+		v /= PARSE_POW10[ -exp10 ];
+	}
+	else
+	{
+		v *= PARSE_POW10[ exp10 ];
+	}
+
+	*d = neg ? -v : v;
+	return s;
+}
+
+
 /**
  * 	\brief	Read next 'int' value from string
  *
@@ -77,9 +571,7 @@ char* string_nextline(char* str, char* start, int len)
  */
 char* string_get_i(char* str, int* i)
 {
-	char* s;
-	*i = (int )strtol(str, &s, 0);
-	return (s == str) ? NULL : s;
+	return const_cast< char* >( string_parse_i( str, NULL, i ) );
 }
 
 
@@ -92,9 +584,7 @@ char* string_get_i(char* str, int* i)
  */
 char* string_get_ui(char* str, unsigned int* ui)
 {
-	char* s;
-	*ui = (unsigned int )strtoul(str, &s, 0);
-	return (s == str) ? NULL : s;
+	return const_cast< char* >( string_parse_ui( str, NULL, ui ) );
 }
 
 
@@ -107,9 +597,7 @@ char* string_get_ui(char* str, unsigned int* ui)
  */
 char* string_get_d(char* str, double* d)
 {
-	char* s;
-	*d = strtod(str, &s);
-	return (s == str) ? NULL : s;
+	return const_cast< char* >( string_parse_d( str, NULL, d ) );
 }
 
 
@@ -122,9 +610,10 @@ char* string_get_d(char* str, double* d)
  */
 char* string_get_f(char* str, float* f)
 {
-	char* s;
-	*f = (float )strtod(str, &s);	// strtof() only available in GNU-C
-	return (s == str) ? NULL : s;
+	double d;
+	char* s = const_cast< char* >( string_parse_d( str, NULL, &d ) );
+	*f = (float )d;
+	return s;
 }
 
 
@@ -140,57 +629,100 @@ char* string_get_f(char* str, float* f)
  */
 char* string_get_block(char* str, const char* fmt, int* idat, float* fdat, double *ddat)
 {
-	char* strend;
-	int index_i, index_f;
+	return const_cast< char* >( string_get_block( static_cast< const char* >( str ), NULL, fmt, idat, fdat, ddat ) );
+}
+
 
-	str = strchr( str, '[' );
-	if ( str == NULL)
+/**
+ * 	\brief Find next block '[...]' in string
+ *
+ *	@param[in] 	str		string
+ *	@param[in] 	end		end of string (behind last character); NULL if string is terminated by '\0'
+ *	@param[out] blockend	position of closing ']'
+ *	@return 	begin of block content (behind '['); NULL in case of error
+ */
+const char* string_find_block(const char* str, const char* end, const char** blockend)
+{
+	str = string_find( str, end, '[' );
+	if ( str == NULL )
 	{       // search begin of block
 		return NULL;
 	}
-	strend = strchr( str, ']' );
-	if ( strend == NULL )
+	*blockend = string_find( str, end, ']' );
+	if ( *blockend == NULL )
 	{    // search end of block
 		return NULL;
 	}
-	str++;                               // remove delimiters
-	*strend = '\0';
+	return str + 1;                      // remove delimiters
+}
+
+
+/**
+ * 	\brief Skip next blocks '[...]' in string, without parsing their content
+ *
+ *	@param[in] 	str		string
+ *	@param[in] 	end		end of string (behind last character); NULL if string is terminated by '\0'
+ *	@param[in] 	num		number of blocks
+ *	@return 	pointer behind last skipped block in str; NULL in case of error
+ */
+const char* string_skip_blocks(const char* str, const char* end, int num)
+{
+	const char* strend;
+
+	for ( int i = 0; i < num; i++ )
+	{
+		if ( string_find_block( str, end, &strend ) == NULL )
+			return NULL;
+
+		str = strend + 1;
+	}
+	return str;
+}
+
+
+/**
+ * 	\brief Process next block '[...]' in string (non-mutating, length-bounded)
+ *
+ *	@param[in] 	str		string
+ *	@param[in] 	end		end of string (behind last character); NULL if string is terminated by '\0'
+ *	@param[in] 	fmt		format string ('i' for 'int', 'f' for 'float', 'd' for 'double')
+ *	@param[out] idat	array for 'int' values (long enough due to fmt)
+ *	@param[out] fdat	array for 'float' values (long enough due to fmt)
+ *	@param[out] ddat	array for 'double' values (long enough due to fmt)
+ *	@return 	pointer behind read value in str; NULL in case of error
+ */
+const char* string_get_block(const char* str, const char* end, const char* fmt, int* idat, float* fdat, double *ddat)
+{
+	const char* strend;
+	int index_i, index_f;
+	double d;
+
+	str = string_find_block( str, end, &strend );
+	if ( str == NULL )
+		return NULL;
+
 	index_i = index_f = 0;
 	while(*fmt)
 	{
 		switch(*fmt++)
 		{
 			case 'i':
-				str = string_get_i( str, &idat[ index_i++ ] );
-				if ( str == NULL )
-				{
-					*strend = ']';
-					return NULL;
-				}
+				str = string_parse_i( str, strend, &idat[ index_i++ ] );
 				break;
 			case 'f':
-				str = string_get_f( str, &fdat[ index_f++ ] );
-				if ( str == NULL )
-				{
-					*strend = ']';
-					return NULL;
-				}
+				str = string_parse_d( str, strend, &d );
+				fdat[ index_f++ ] = (float )d;
 				break;
 			case 'd':
-				str = string_get_d( str, &ddat[ index_f++ ] );
-				if ( str == NULL )
-				{
-					*strend = ']';
-					return NULL;
-				}
+				str = string_parse_d( str, strend, &ddat[ index_f++ ] );
 				break;
 			default:	// unknown format character
-				*strend = ']';
 				return NULL;
 		}
+		if ( str == NULL )
+			return NULL;
 	}
 	// ignore additional data inside the block
-	*strend = ']';
 	return strend + 1;
 }
 
@@ -204,21 +736,35 @@ char* string_get_block(char* str, const char* fmt, int* idat, float* fdat, doubl
  */
 char* string_get_word(char* str, std::string& w)
 {
-	char* strend;
-	while (*str == ' ')
+	return const_cast< char* >( string_get_word( static_cast< const char* >( str ), NULL, w ) );
+}
+
+
+/**
+ * 	\brief	Read next 'word' value from string (non-mutating, length-bounded)
+ *
+ *	@param[in] 	str		string
+ *	@param[in] 	end		end of string (behind last character); NULL if string is terminated by '\0'
+ *	@param[out] w		read value
+ *	@return		pointer behind read value in str; NULL in case of error
+ */
+const char* string_get_word(const char* str, const char* end, std::string& w)
+{
+	const char* strend;
+	while (str != end && *str == ' ')
 	{	// search begin of 'word'
 		str++;
 	}
 
-	strend = strchr( str, ' ' );	// search end of 'word'
+	strend = string_find( str, end, ' ' );	// search end of 'word'
 	if ( strend == NULL )
 	{
-		w.assign(str);
 		strend = str;
-		while (*strend != '\0')
+		while (strend != end && *strend != '\0')
 		{	// search end of 'word'
 			strend++;
 		}
+		w.assign(str, (int )(strend - str));
 		return (strend == str) ? NULL : strend;
 	}
 	w.assign(str, (int )(strend - str));
@@ -235,16 +781,30 @@ char* string_get_word(char* str, std::string& w)
  */
 char* string_get_quoted_text(char* str, std::string& qt)
 {
-	char* strend;
+	return const_cast< char* >( string_get_quoted_text( static_cast< const char* >( str ), NULL, qt ) );
+}
+
+
+/**
+ * 	\brief	Read next 'quoted text' value from string (non-mutating, length-bounded)
+ *
+ *	@param[in] 	str		string
+ *	@param[in] 	end		end of string (behind last character); NULL if string is terminated by '\0'
+ *	@param[out] qt		read value (without quotes)
+ *	@return		pointer behind read value in str; NULL in case of error
+ */
+const char* string_get_quoted_text(const char* str, const char* end, std::string& qt)
+{
+	const char* strend;
 
-	str = strchr( str, '\"' );	// search begin of 'quoted text'
+	str = string_find( str, end, '\"' );	// search begin of 'quoted text'
 	if ( str == NULL )
 	{
 		return NULL;
 	}
 	str++;
 
-	strend = strchr( str, '\"' );	// search end of 'quoted text'
+	strend = string_find( str, end, '\"' );	// search end of 'quoted text'
 	if ( strend == NULL )
 	{
 		return NULL;
@@ -35,6 +35,7 @@
 #define _ART_DTRACKPARSE_H_
 
 #include <string>
+#include <vector>
 
 namespace DTrackSDK_Parse {
 
@@ -47,6 +48,71 @@ namespace DTrackSDK_Parse {
  */
 char* string_nextline(char* str, char* start, int len);
 
+/**
+ *	\brief	Search next line in buffer (non-mutating, length-bounded)
+ *
+ *	A '\0' character is not treated as end of buffer.
+ *
+ *	@param[in] 	start	start position within buffer
+ *	@param[in] 	end		end of buffer (behind last character)
+ *	@return		begin of line, NULL if no new line in buffer
+ */
+const char* string_nextline(const char* start, const char* end);
+
+/**
+ *	\brief	Find begin of all lines in buffer, in one pass (vectorized if SSE2/AVX2/NEON is available)
+ *
+ *	Gives the same lines as repeated calls of string_nextline(). The first line always starts at
+ *	the begin of the buffer.
+ *
+ *	@param[in] 	str		begin of buffer
+ *	@param[in] 	end		end of buffer (behind last character)
+ *	@param[out] offsets	offsets of all line begins relative to str
+ *	@return		number of lines
+ */
+int string_index_lines(const char* str, const char* end, std::vector< int >& offsets);
+
+/**
+ * 	\brief	Parse 'int' value (DTrack number format, independent of locale)
+ *
+ *	Leading white spaces are skipped. Behaves like strtol() with base 0; numbers with more
+ *	than 63 characters are rejected.
+ *
+ *	@param[in] 	first	begin of string
+ *	@param[in] 	last	end of string; NULL if string is terminated by '\0'
+ *	@param[out] i		parsed value
+ *	@return		pointer behind parsed value; NULL in case of error
+ */
+const char* string_parse_i(const char* first, const char* last, int* i);
+
+/**
+ * 	\brief	Parse 'unsigned int' value (DTrack number format, independent of locale)
+ *
+ *	Leading white spaces are skipped. Behaves like strtoul() with base 0; numbers with more
+ *	than 63 characters are rejected.
+ *
+ *	@param[in] 	first	begin of string
+ *	@param[in] 	last	end of string; NULL if string is terminated by '\0'
+ *	@param[out] ui		parsed value
+ *	@return		pointer behind parsed value; NULL in case of error
+ */
+const char* string_parse_ui(const char* first, const char* last, unsigned int* ui);
+
+/**
+ * 	\brief	Parse 'double' value (DTrack number format, independent of locale)
+ *
+ *	Leading white spaces are skipped. Always uses '.' as decimal point and gives
+ *	exactly the same result as strtod() in the "C" locale, without changing the
+ *	locale of the process. Numbers with more than 63 characters, that cannot be parsed by
+ *	the fast path, are rejected.
+ *
+ *	@param[in] 	first	begin of string
+ *	@param[in] 	last	end of string; NULL if string is terminated by '\0'
+ *	@param[out] d		parsed value
+ *	@return		pointer behind parsed value; NULL in case of error
+ */
+const char* string_parse_d(const char* first, const char* last, double* d);
+
 /**
  * 	\brief	Read next 'int' value from string
  *
@@ -95,6 +161,177 @@ char* string_get_f(char* str, float* f);
  */
 char* string_get_block(char* str, const char* fmt, int* idat = NULL, float* fdat = NULL, double *ddat = NULL);
 
+/**
+ * 	\brief Process next block '[...]' in string (non-mutating, length-bounded)
+ *
+ *	The string is never written to, so it may reside in read-only memory.
+ *
+ *	@param[in] 	str		string
+ *	@param[in] 	end		end of string (behind last character); NULL if string is terminated by '\0'
+ *	@param[in] 	fmt		format string ('i' for 'int', 'f' for 'float', 'd' for 'double')
+ *	@param[out] idat	array for 'int' values (long enough due to fmt)
+ *	@param[out] fdat	array for 'float' values (long enough due to fmt)
+ *	@param[out] ddat	array for 'double' values (long enough due to fmt)
+ *	@return 	pointer behind read value in str; NULL in case of error
+ */
+const char* string_get_block(const char* str, const char* end, const char* fmt, int* idat, float* fdat, double *ddat);
+
+/**
+ * 	\brief Find next block '[...]' in string
+ *
+ *	@param[in] 	str		string
+ *	@param[in] 	end		end of string (behind last character); NULL if string is terminated by '\0'
+ *	@param[out] blockend	position of closing ']'
+ *	@return 	begin of block content (behind '['); NULL in case of error
+ */
+const char* string_find_block(const char* str, const char* end, const char** blockend);
+
+/**
+ * 	\brief Skip next blocks '[...]' in string, without parsing their content
+ *
+ *	@param[in] 	str		string
+ *	@param[in] 	end		end of string (behind last character); NULL if string is terminated by '\0'
+ *	@param[in] 	num		number of blocks
+ *	@return 	pointer behind last skipped block in str; NULL in case of error
+ */
+const char* string_skip_blocks(const char* str, const char* end, int num);
+
+/**
+ * 	\brief	Parse value of given type (DTrack number format, independent of locale)
+ *
+ *	Overloads of string_parse_i() and string_parse_d(), to be used by templates.
+ */
+inline const char* string_parse_value(const char* first, const char* last, int* v)
+{
+	return string_parse_i( first, last, v );
+}
+
+inline const char* string_parse_value(const char* first, const char* last, double* v)
+{
+	return string_parse_d( first, last, v );
+}
+
+inline const char* string_parse_value(const char* first, const char* last, float* v)
+{
+	double d;
+
+	first = string_parse_d( first, last, &d );
+	*v = ( float )d;
+	return first;
+}
+
+/**
+ * 	\brief	Parse fixed number of values of same type (inside of a block)
+ *
+ *	@param[in] 	first	begin of string
+ *	@param[in] 	last	end of string
+ *	@param[out] dat		array for N values
+ *	@return		pointer behind parsed values; NULL in case of error
+ */
+template< typename T, int N >
+inline const char* string_parse_values(const char* first, const char* last, T* dat)
+{
+	for ( int k = 0; k < N; k++ )
+	{
+		first = string_parse_value( first, last, &dat[ k ] );
+		if ( first == NULL )
+			return NULL;
+	}
+	return first;
+}
+
+/**
+ * 	\brief Process next block '[...]' in string, with block format fixed at compile time
+ *
+ *	Same as string_get_block() with a format string of N times the type T, e.g.
+ *	string_get_block< double, 3 >( str, end, loc ) instead of format "ddd".
+ *
+ *	@param[in] 	str		string
+ *	@param[in] 	end		end of string (behind last character); NULL if string is terminated by '\0'
+ *	@param[out] dat		array for N values
+ *	@return 	pointer behind read value in str; NULL in case of error
+ */
+template< typename T, int N >
+inline const char* string_get_block(const char* str, const char* end, T* dat)
+{
+	const char* strend;
+
+	str = string_find_block( str, end, &strend );
+	if ( str == NULL )
+		return NULL;
+
+	if ( string_parse_values< T, N >( str, strend, dat ) == NULL )
+		return NULL;
+
+	// ignore additional data inside the block
+	return strend + 1;
+}
+
+/**
+ * 	\brief Process next block '[...]' in string, consisting of two groups of values
+ *
+ *	E.g. string_get_block< int, 1, double, 1 >( str, end, &id, &qu ) instead of format "id".
+ *
+ *	@param[in] 	str		string
+ *	@param[in] 	end		end of string (behind last character); NULL if string is terminated by '\0'
+ *	@param[out] dat1	array for N1 values of first group
+ *	@param[out] dat2	array for N2 values of second group
+ *	@return 	pointer behind read value in str; NULL in case of error
+ */
+template< typename T1, int N1, typename T2, int N2 >
+inline const char* string_get_block(const char* str, const char* end, T1* dat1, T2* dat2)
+{
+	const char* strend;
+
+	str = string_find_block( str, end, &strend );
+	if ( str == NULL )
+		return NULL;
+
+	str = string_parse_values< T1, N1 >( str, strend, dat1 );
+	if ( str == NULL )
+		return NULL;
+
+	if ( string_parse_values< T2, N2 >( str, strend, dat2 ) == NULL )
+		return NULL;
+
+	return strend + 1;
+}
+
+/**
+ * 	\brief Process next block '[...]' in string, consisting of three groups of values
+ *
+ *	E.g. string_get_block< int, 1, double, 1, int, 2 >( str, end, &id, &qu, iarr ) instead of format "idii".
+ *
+ *	@param[in] 	str		string
+ *	@param[in] 	end		end of string (behind last character); NULL if string is terminated by '\0'
+ *	@param[out] dat1	array for N1 values of first group
+ *	@param[out] dat2	array for N2 values of second group
+ *	@param[out] dat3	array for N3 values of third group
+ *	@return 	pointer behind read value in str; NULL in case of error
+ */
+template< typename T1, int N1, typename T2, int N2, typename T3, int N3 >
+inline const char* string_get_block(const char* str, const char* end, T1* dat1, T2* dat2, T3* dat3)
+{
+	const char* strend;
+
+	str = string_find_block( str, end, &strend );
+	if ( str == NULL )
+		return NULL;
+
+	str = string_parse_values< T1, N1 >( str, strend, dat1 );
+	if ( str == NULL )
+		return NULL;
+
+	str = string_parse_values< T2, N2 >( str, strend, dat2 );
+	if ( str == NULL )
+		return NULL;
+
+	if ( string_parse_values< T3, N3 >( str, strend, dat3 ) == NULL )
+		return NULL;
+
+	return strend + 1;
+}
+
 /**
  * 	\brief	Read next 'word' value from string
  *
@@ -104,6 +341,16 @@ char* string_get_block(char* str, const char* fmt, int* idat = NULL, float* fdat
  */
 char* string_get_word(char* str, std::string& w);
 
+/**
+ * 	\brief	Read next 'word' value from string (non-mutating, length-bounded)
+ *
+ *	@param[in] 	str		string
+ *	@param[in] 	end		end of string (behind last character); NULL if string is terminated by '\0'
+ *	@param[out] w		read value
+ *	@return	pointer behind read value in str; NULL in case of error
+ */
+const char* string_get_word(const char* str, const char* end, std::string& w);
+
 /**
  * 	\brief	Read next 'quoted text' value from string
  *
@@ -113,6 +360,16 @@ char* string_get_word(char* str, std::string& w);
  */
 char* string_get_quoted_text(char* str, std::string& qt);
 
+/**
+ * 	\brief	Read next 'quoted text' value from string (non-mutating, length-bounded)
+ *
+ *	@param[in] 	str		string
+ *	@param[in] 	end		end of string (behind last character); NULL if string is terminated by '\0'
+ *	@param[out] qt		read value (without quotes)
+ *	@return pointer behind read value in str; NULL in case of error
+ */
+const char* string_get_quoted_text(const char* str, const char* end, std::string& qt);
+
 /**
  * 	\brief	Compare strings regarding DTrack2 parameter rules
  *
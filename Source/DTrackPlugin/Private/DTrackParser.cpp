@@ -37,6 +37,7 @@
 #include "DTrackParser.hpp"
 #include "DTrackParse.hpp"
 
+#include <algorithm>
 #include <cstring>
 
 #if ! defined( _MSC_VER )
@@ -60,6 +61,13 @@ static void reduced_to_full_cov( double* cov_full, const double* cov_reduced, in
 }
 
 
+/** Checks if a line of a tracking data packet starts with the given identifier (without reading beyond the end of the packet) */
+static inline bool line_starts_with( const char* line, const char* end, const char* ident, int len )
+{
+	return ( ( end - line ) >= len ) && ( memcmp( line, ident, len ) == 0 );
+}
+
+
 /*
  * Constructor.
  */
@@ -72,6 +80,12 @@ DTrackParser::DTrackParser()
 	act_num_body = act_num_flystick = act_num_meatool = act_num_mearef = act_num_hand = act_num_human = 0;
 	act_num_inertial = 0;
 	act_num_marker = 0;
+	
+	act_pose_arrays_enabled = false;
+	act_frame_buffer = NULL;
+	
+	loc_line_mask = LINE_MASK_ALL;
+	resetLineCounters();
 }
 
 
@@ -93,6 +107,68 @@ void DTrackParser::startFrame()
 	act_timestamp = -1;   // i.e. not available
 	loc_num_bodycal = loc_num_handcal = -1;  // i.e. not available
 	loc_num_flystick1 = loc_num_meatool1 = 0;
+	
+	act_body_changes.startFrame();
+	act_hand_changes.startFrame();
+	act_inertial_changes.startFrame();
+}
+
+
+/*
+ * Empties list at start of a new frame.
+ */
+void DTrackParser::ChangeList::startFrame()
+{
+	for (size_t i=0; i<changed.size(); i++)
+		is_changed[ changed[i] ] = 0;
+	
+	changed.clear();
+}
+
+
+/*
+ * Marks ids of the frame before as changed, at start of parsing a new line.
+ */
+void DTrackParser::ChangeList::startLine()
+{
+	startFrame();  // in case of several lines per frame
+	
+	for (size_t i=0; i<tracked.size(); i++) {
+		if (!is_changed[ tracked[i] ]) {
+			is_changed[ tracked[i] ] = 1;
+			changed.push_back( tracked[i] );
+		}
+	}
+	
+	tracked.clear();
+}
+
+
+/*
+ * Adds id of a record contained in the current line.
+ */
+void DTrackParser::ChangeList::add( int id )
+{
+	if (id >= (int )is_changed.size())
+		is_changed.resize(id + 1, 0);
+	
+	tracked.push_back(id);
+	
+	if (!is_changed[id]) {
+		is_changed[id] = 1;
+		changed.push_back(id);
+	}
+}
+
+
+/*
+ * Removes all ids.
+ */
+void DTrackParser::ChangeList::clear()
+{
+	tracked.clear();
+	changed.clear();
+	is_changed.clear();
 }
 
 
@@ -129,117 +205,544 @@ void DTrackParser::endFrame()
 		}
 		act_num_hand = loc_num_handcal;
 	}
+	
+	if (act_pose_arrays_enabled)
+		fillPoseArrays();
+	
+	if (act_frame_buffer != NULL)
+		publishFrame();
 }
 
 
 /*
- * Parses a single line of data in one tracking data packet.
+ * Copies the data of the current frame into the frame buffer.
  */
-bool DTrackParser::parseLine(char **line)
+void DTrackParser::publishFrame()
 {
-	if (!line)
-		return false;
+	DTrackFrame* frame = act_frame_buffer->beginWrite();
+	if (frame == NULL)  // all frames are held by readers
+		return;
 	
-	// line of frame counter:
-	if (!strncmp(*line, "fr ", 3)) {
-		*line += 3;
-		return parseLine_fr(line);
+	// no allocations, as soon as capacities fit:
+	frame->framecounter = act_framecounter;
+	frame->timestamp = act_timestamp;
+	frame->body.assign(act_body.begin(), act_body.begin() + act_num_body);
+	frame->flystick.assign(act_flystick.begin(), act_flystick.begin() + act_num_flystick);
+	frame->meatool.assign(act_meatool.begin(), act_meatool.begin() + act_num_meatool);
+	frame->hand.assign(act_hand.begin(), act_hand.begin() + act_num_hand);
+	
+	// joints are copied into the frame, the pointers are moved from the pool to the frame's own storage
+	int i, num_joint = 0;
+	for (i=0; i<act_num_human; i++)
+		num_joint += act_human[i].num_joints;
+	
+	frame->human.assign(act_human.begin(), act_human.begin() + act_num_human);
+	frame->human_joint.resize(num_joint);
+	num_joint = 0;
+	for (i=0; i<act_num_human; i++) {
+		if (frame->human[i].joint == NULL)
+			continue;
+		
+		std::copy(act_human[i].joint, act_human[i].joint + act_human[i].num_joints, frame->human_joint.begin() + num_joint);
+		frame->human[i].joint = &frame->human_joint[num_joint];
+		num_joint += act_human[i].num_joints;
 	}
 	
-	// line of timestamp:
-	if (!strncmp(*line, "ts ", 3)) {
-		*line += 3;
-		return parseLine_ts(line);
+	frame->inertial.assign(act_inertial.begin(), act_inertial.begin() + act_num_inertial);
+	frame->marker.assign(act_marker.begin(), act_marker.begin() + act_num_marker);
+	
+	act_frame_buffer->endWrite();
+}
+
+
+/*
+ * Set buffer, where each frame is published at its end.
+ */
+void DTrackParser::setFrameBuffer( DTrackFrameBuffer* buffer )
+{
+	act_frame_buffer = buffer;
+}
+
+
+/*
+ * Get buffer, where each frame is published at its end.
+ */
+DTrackFrameBuffer* DTrackParser::getFrameBuffer() const
+{
+	return act_frame_buffer;
+}
+
+
+/** Sets the number of entries of pose arrays */
+static void pose_arrays_resize( DTrackPoseArrays& poses, int num )
+{
+	poses.num = num;
+	poses.id.resize(num);
+	poses.quality.resize(num);
+	poses.loc_x.resize(num);
+	poses.loc_y.resize(num);
+	poses.loc_z.resize(num);
+	for (int k=0; k<9; k++)
+		poses.rot[k].resize(num);
+}
+
+
+/** Sets one entry of pose arrays */
+static inline void pose_arrays_set( DTrackPoseArrays& poses, int i, int id, double quality, const double loc[3], const double rot[9] )
+{
+	poses.id[i] = id;
+	poses.quality[i] = quality;
+	poses.loc_x[i] = loc[0];
+	poses.loc_y[i] = loc[1];
+	poses.loc_z[i] = loc[2];
+	for (int k=0; k<9; k++)
+		poses.rot[k][i] = rot[k];
+}
+
+
+/*
+ * Fills pose arrays with the data of the current frame.
+ */
+void DTrackParser::fillPoseArrays()
+{
+	int i, n;
+	
+	// changed standard bodies (without bodies, that are not calibrated anymore):
+	pose_arrays_resize(act_body_pose_arrays, getNumChangedBody());
+	n = 0;
+	for (i=0; i<getNumChangedBody(); i++) {
+		const DTrackBody* body = getChangedBody(i);
+		if (body != NULL)
+			pose_arrays_set(act_body_pose_arrays, n++, body->id, body->quality, body->loc, body->rot);
 	}
+	pose_arrays_resize(act_body_pose_arrays, n);
 	
-	// line of additional inofmation about number of calibrated bodies:
-	if (!strncmp(*line, "6dcal ", 6)) {
-		*line += 6;
-		return parseLine_6dcal(line);
+	// all Flysticks:
+	pose_arrays_resize(act_flystick_pose_arrays, act_num_flystick);
+	for (i=0; i<act_num_flystick; i++) {
+		const DTrackFlyStick& flystick = act_flystick[i];
+		pose_arrays_set(act_flystick_pose_arrays, i, flystick.id, flystick.quality, flystick.loc, flystick.rot);
 	}
 	
-	// line of standard body data:
-	if (!strncmp(*line, "6d ", 3)) {
-		*line += 3;
-		return parseLine_6d(line);
+	// changed hybrid bodies:
+	pose_arrays_resize(act_inertial_pose_arrays, getNumChangedInertial());
+	n = 0;
+	for (i=0; i<getNumChangedInertial(); i++) {
+		const DTrackInertial* inertial = getChangedInertial(i);
+		if (inertial != NULL)
+			pose_arrays_set(act_inertial_pose_arrays, n++, inertial->id, inertial->isTracked() ? 1.0 : -1.0, inertial->loc, inertial->rot);
 	}
+	pose_arrays_resize(act_inertial_pose_arrays, n);
+	
+	// rotations also as quaternions, all entries in one pass:
+	rot2quat(act_body_pose_arrays);
+	rot2quat(act_flystick_pose_arrays);
+	rot2quat(act_inertial_pose_arrays);
+}
 
-	// line of 6d covariance data:
-	if (!strncmp(*line, "6dcov ", 6)) {
-		*line += 6;
-		return parseLine_6dcov(line);
-	}
+
+/*
+ * Enable filling of pose arrays at the end of each frame.
+ */
+void DTrackParser::setPoseArraysEnabled( bool enable )
+{
+	act_pose_arrays_enabled = enable;
 	
-	// line of Flystick data (older format):
-	if (!strncmp(*line, "6df ", 4)) {
-		*line += 4;
-		return parseLine_6df(line);
+	if (!enable) {
+		pose_arrays_resize(act_body_pose_arrays, 0);
+		pose_arrays_resize(act_flystick_pose_arrays, 0);
+		pose_arrays_resize(act_inertial_pose_arrays, 0);
 	}
+}
+
+
+/*
+ * Get if pose arrays are filled at the end of each frame.
+ */
+bool DTrackParser::isPoseArraysEnabled() const
+{
+	return act_pose_arrays_enabled;
+}
+
+
+/*
+ * Get poses of standard bodies, as structure of arrays.
+ */
+const DTrackPoseArrays& DTrackParser::getBodyPoseArrays() const
+{
+	return act_body_pose_arrays;
+}
+
+
+/*
+ * Get poses of Flysticks, as structure of arrays.
+ */
+const DTrackPoseArrays& DTrackParser::getFlyStickPoseArrays() const
+{
+	return act_flystick_pose_arrays;
+}
+
+
+/*
+ * Get poses of hybrid (optical-inertial) bodies, as structure of arrays.
+ */
+const DTrackPoseArrays& DTrackParser::getInertialPoseArrays() const
+{
+	return act_inertial_pose_arrays;
+}
+
+
+/*
+ * Parses a single line of data in one tracking data packet.
+ */
+bool DTrackParser::parseLine( const char** line, const char* end )
+{
+	if (!line)
+		return false;
 	
-	// line of Flystick data (newer format):
-	if (!strncmp(*line, "6df2 ", 5)) {
-		*line += 5;
-		return parseLine_6df2(line);
-	}
+	return parseLine( getLineType( *line, end ), line, end );
+}
+
+
+/*
+ * Parses all lines of one tracking data packet.
+ */
+bool DTrackParser::parsePacket( const char* data, const char* end )
+{
+	int i, n;
 	
-	// line of measurement tool data (older format):
-	if (!strncmp(*line, "6dmt ", 5)) {
-		*line += 5;
-		return parseLine_6dmt(line);
+	// find begin and type of all lines:
+	n = string_index_lines( data, end, loc_line_offsets );
+	
+	loc_line_index.resize( n );
+	for (i=0; i<n; i++) {
+		loc_line_index[i].offset = loc_line_offsets[i];
+		loc_line_index[i].type = getLineType( data + loc_line_offsets[i], end );
 	}
 	
-	// line of measurement tool data (newer format):
-	if (!strncmp(*line, "6dmt2 ", 6)) {
-		*line += 6;
-		return parseLine_6dmt2(line);
+	// process lines:
+	for (i=0; i<n; i++) {
+		const char* s = data + loc_line_index[i].offset;
+		
+		if (!parseLine( loc_line_index[i].type, &s, end ))
+			return false;
 	}
 	
-	// line of measurement reference data:
-	if (!strncmp(*line, "6dmtr ", 6)) {
-		*line += 6;
-		return parseLine_6dmtr(line);
+	return true;
+}
+
+
+/** Identifiers of all line types (including separating space), in order of LineType */
+static const struct {
+	const char* ident;
+	int len;
+	const char* name;
+} LINE_IDENTS[ DTrackParser::LINE_NUM ] = {
+	{ "",       0, "unknown" },  // LINE_UNKNOWN
+	{ "fr ",    3, "fr" },
+	{ "ts ",    3, "ts" },
+	{ "6dcal ", 6, "6dcal" },
+	{ "6d ",    3, "6d" },
+	{ "6dcov ", 6, "6dcov" },
+	{ "6df ",   4, "6df" },
+	{ "6df2 ",  5, "6df2" },
+	{ "6dmt ",  5, "6dmt" },
+	{ "6dmt2 ", 6, "6dmt2" },
+	{ "6dmtr ", 6, "6dmtr" },
+	{ "glcal ", 6, "glcal" },
+	{ "gl ",    3, "gl" },
+	{ "6dj ",   4, "6dj" },
+	{ "6di ",   4, "6di" },
+	{ "3d ",    3, "3d" },
+};
+
+
+/** Returns character at given position of a line, '\0' if behind the end of the packet */
+static inline char line_char( const char* line, const char* end, int pos )
+{
+	return ( ( end - line ) > pos ) ? line[ pos ] : '\0';
+}
+
+
+/*
+ * Determines the type of a line in one tracking data packet.
+ *
+ * Selects the only possible candidate by the first characters of the line, so that
+ * just one identifier has to be compared, independent of the line type.
+ */
+DTrackParser::LineType DTrackParser::getLineType( const char* line, const char* end )
+{
+	LineType type = LINE_UNKNOWN;
+	
+	switch (line_char(line, end, 0)) {
+		case 'f':  type = LINE_FR;  break;
+		case 't':  type = LINE_TS;  break;
+		case '3':  type = LINE_3D;  break;
+		case 'g':
+			type = (line_char(line, end, 2) == 'c') ? LINE_GLCAL : LINE_GL;
+			break;
+		case '6':
+			switch (line_char(line, end, 2)) {
+				case ' ':  type = LINE_6D;  break;
+				case 'c':  type = (line_char(line, end, 3) == 'a') ? LINE_6DCAL : LINE_6DCOV;  break;
+				case 'f':  type = (line_char(line, end, 3) == '2') ? LINE_6DF2 : LINE_6DF;  break;
+				case 'j':  type = LINE_6DJ;  break;
+				case 'i':  type = LINE_6DI;  break;
+				case 'm':
+					switch (line_char(line, end, 4)) {
+						case '2':  type = LINE_6DMT2;  break;
+						case 'r':  type = LINE_6DMTR;  break;
+						default:   type = LINE_6DMT;   break;
+					}
+					break;
+				default:
+					break;
+			}
+			break;
+		default:
+			break;
 	}
 	
-	// line of additional inofmation about number of calibrated Fingertracking hands:
-	if (!strncmp(*line, "glcal ", 6)) {
-		*line += 6;
-		return parseLine_glcal(line);
+	if (type == LINE_UNKNOWN || !line_starts_with(line, end, LINE_IDENTS[type].ident, LINE_IDENTS[type].len))
+		return LINE_UNKNOWN;
+	
+	return type;
+}
+
+
+/** Line types, that are always parsed (needed for frame and number of calibrated bodies and hands) */
+static const unsigned int LINE_MASK_REQUIRED = ( 1u << DTrackParser::LINE_FR ) | ( 1u << DTrackParser::LINE_TS )
+                                             | ( 1u << DTrackParser::LINE_6DCAL ) | ( 1u << DTrackParser::LINE_GLCAL );
+
+
+/*
+ * Set line types, that should be parsed.
+ */
+void DTrackParser::setSubscribedLineTypes( unsigned int mask )
+{
+	unsigned int removed;
+	
+	mask |= LINE_MASK_REQUIRED;
+	removed = loc_line_mask & ~mask;
+	loc_line_mask = mask;
+	
+	// data of unsubscribed line types is not available anymore:
+	if (removed & getLineTypeBit(LINE_6D)) {
+		act_num_body = 0;  // recreated by '6dcal'
+		act_body.clear();
+		act_body_changes.clear();
+	}
+	if (removed & (getLineTypeBit(LINE_6DF) | getLineTypeBit(LINE_6DF2))) {
+		act_num_flystick = 0;
+		act_flystick.clear();
+	}
+	if (removed & (getLineTypeBit(LINE_6DMT) | getLineTypeBit(LINE_6DMT2))) {
+		act_num_meatool = 0;
+		act_meatool.clear();
+	}
+	if (removed & getLineTypeBit(LINE_6DMTR)) {
+		act_num_mearef = 0;
+		act_mearef.clear();
+	}
+	if (removed & getLineTypeBit(LINE_GL)) {
+		act_num_hand = 0;  // recreated by 'glcal'
+		act_hand.clear();
+		act_hand_changes.clear();
 	}
+	if (removed & getLineTypeBit(LINE_6DJ)) {
+		act_num_human = 0;
+		act_human.clear();
+		act_human_joint.clear();
+	}
+	if (removed & getLineTypeBit(LINE_6DI)) {
+		act_num_inertial = 0;
+		act_inertial.clear();
+		act_inertial_changes.clear();
+	}
+	if (removed & getLineTypeBit(LINE_3D)) {
+		act_num_marker = 0;
+	}
+}
+
+
+/*
+ * Get line types, that are parsed.
+ */
+unsigned int DTrackParser::getSubscribedLineTypes() const
+{
+	return loc_line_mask;
+}
+
+
+/*
+ * Set ids of standard bodies, that should be parsed.
+ */
+void DTrackParser::setSubscribedBodies( const std::vector< int >& ids )
+{
+	loc_body_filter.clear();
+	for (size_t i=0; i<ids.size(); i++) {
+		if (ids[i] < 0)
+			continue;
+		
+		if (ids[i] >= (int )loc_body_filter.size())
+			loc_body_filter.resize(ids[i] + 1, 0);
+		
+		loc_body_filter[ ids[i] ] = 1;
+	}
+	
+	if (ids.empty())
+		return;
 	
-	// line of A.R.T. Fingertracking hand data:
-	if (!strncmp(*line, "gl ", 3)) {
-		*line += 3;
-		return parseLine_gl(line);
+	// data of unsubscribed bodies is not available anymore:
+	for (int id=0; id<act_num_body; id++) {
+		if (!isBodySubscribed(id)) {
+			memset(&act_body[id], 0, sizeof(DTrack_Body_Type_d));
+			act_body[id].id = id;
+			act_body[id].quality = -1;
+		}
 	}
+	act_body_changes.clear();
+}
+
+
+/*
+ * Get if a standard body is parsed.
+ */
+bool DTrackParser::isBodySubscribed( int id ) const
+{
+	if (loc_body_filter.empty())
+		return true;
+	
+	return (id >= 0) && (id < (int )loc_body_filter.size()) && (loc_body_filter[ id ] != 0);
+}
+
+
+/*
+ * Get number of standard body records, that were skipped as not subscribed.
+ */
+unsigned int DTrackParser::getNumSkippedBodies() const
+{
+	return loc_body_skipped.load( std::memory_order_relaxed );
+}
+
+
+/*
+ * Skips a single line of an unsubscribed type in one tracking data packet.
+ */
+bool DTrackParser::skipLine( LineType type, const char** line, const char* end )
+{
+	int n;
 	
-	// line of 6dj human model data:
-	if (!strncmp(*line, "6dj ", 4))	{
-		*line += 4;
-		return parseLine_6dj(line);
+	// older Flystick and Measurement Tool formats are included in '6dcal', their number is still needed:
+	if (type == LINE_6DF || type == LINE_6DMT) {
+		if (string_parse_i( *line, end, &n ) == NULL)
+			return false;
+		
+		if (type == LINE_6DF)
+			loc_num_flystick1 = n;
+		else
+			loc_num_meatool1 = n;
 	}
 	
-	// line of 6di inertial data:
-	if (!strncmp(*line, "6di ", 4))	{
-		*line += 4;
-		return parseLine_6di(line);
+	return true;
+}
+
+
+/*
+ * Get name of a line type.
+ */
+const char* DTrackParser::getLineTypeName( LineType type )
+{
+	if (type < 0 || type >= LINE_NUM)
+		return LINE_IDENTS[ LINE_UNKNOWN ].name;
+	
+	return LINE_IDENTS[ type ].name;
+}
+
+
+/*
+ * Get number of parsed lines of one type.
+ */
+unsigned int DTrackParser::getNumParsedLines( LineType type ) const
+{
+	if (type < 0 || type >= LINE_NUM)
+		return 0;
+	
+	return loc_line_count[ type ].load( std::memory_order_relaxed );
+}
+
+
+/*
+ * Get number of lines of one type, that could not be parsed.
+ */
+unsigned int DTrackParser::getNumParseErrors( LineType type ) const
+{
+	if (type < 0 || type >= LINE_NUM)
+		return 0;
+	
+	return loc_line_errors[ type ].load( std::memory_order_relaxed );
+}
+
+
+/*
+ * Reset counters of parsed lines.
+ */
+void DTrackParser::resetLineCounters()
+{
+	for (int i=0; i<LINE_NUM; i++) {
+		loc_line_count[i].store( 0, std::memory_order_relaxed );
+		loc_line_errors[i].store( 0, std::memory_order_relaxed );
 	}
+	loc_body_skipped.store( 0, std::memory_order_relaxed );
+}
+
+
+/*
+ * Parses a single line of data of known type in one tracking data packet.
+ */
+bool DTrackParser::parseLine( LineType type, const char** line, const char* end )
+{
+	bool ok = true;
+	
+	*line += LINE_IDENTS[type].len;  // skip identifier
+	loc_line_count[type].fetch_add( 1, std::memory_order_relaxed );
+	
+	if (!(loc_line_mask & getLineTypeBit(type)))
+		return skipLine(type, line, end);
 	
-	// line of single marker data:
-	if (!strncmp(*line, "3d ", 3)) {
-		*line += 3;
-		return parseLine_3d(line);
+	switch (type) {
+		case LINE_FR:     ok = parseLine_fr(line, end);      break;  // line of frame counter
+		case LINE_TS:     ok = parseLine_ts(line, end);      break;  // line of timestamp
+		case LINE_6DCAL:  ok = parseLine_6dcal(line, end);   break;  // line of additional information about number of calibrated bodies
+		case LINE_6D:     ok = parseLine_6d(line, end);      break;  // line of standard body data
+		case LINE_6DCOV:  ok = parseLine_6dcov(line, end);   break;  // line of 6d covariance data
+		case LINE_6DF:    ok = parseLine_6df(line, end);     break;  // line of Flystick data (older format)
+		case LINE_6DF2:   ok = parseLine_6df2(line, end);    break;  // line of Flystick data (newer format)
+		case LINE_6DMT:   ok = parseLine_6dmt(line, end);    break;  // line of measurement tool data (older format)
+		case LINE_6DMT2:  ok = parseLine_6dmt2(line, end);   break;  // line of measurement tool data (newer format)
+		case LINE_6DMTR:  ok = parseLine_6dmtr(line, end);   break;  // line of measurement reference data
+		case LINE_GLCAL:  ok = parseLine_glcal(line, end);   break;  // line of additional information about number of calibrated Fingertracking hands
+		case LINE_GL:     ok = parseLine_gl(line, end);      break;  // line of A.R.T. Fingertracking hand data
+		case LINE_6DJ:    ok = parseLine_6dj(line, end);     break;  // line of 6dj human model data
+		case LINE_6DI:    ok = parseLine_6di(line, end);     break;  // line of 6di inertial data
+		case LINE_3D:     ok = parseLine_3d(line, end);      break;  // line of single marker data
+		default:
+			break;  // ignore unknown line identifiers (could be valid in future DTracks)
 	}
 	
-	return true;  // ignore unknown line identifiers (could be valid in future DTracks)
+	if (!ok)
+		loc_line_errors[type].fetch_add( 1, std::memory_order_relaxed );
+	
+	return ok;
 }
 
 
 /*
  * Parses a single line of frame counter data in one tracking data packet.
  */
-bool DTrackParser::parseLine_fr(char **line)
+bool DTrackParser::parseLine_fr( const char** line, const char* end )
 {
-	*line = string_get_ui( *line, &act_framecounter );
+	*line = string_parse_ui( *line, end, &act_framecounter );
 	if ( *line == NULL )
 	{
 		act_framecounter = 0;
@@ -253,9 +756,9 @@ bool DTrackParser::parseLine_fr(char **line)
 /*
  * Parses a single line of timestamp data in one tracking data packet.
  */
-bool DTrackParser::parseLine_ts(char **line)
+bool DTrackParser::parseLine_ts( const char** line, const char* end )
 {
-	*line = string_get_d( *line, &act_timestamp );
+	*line = string_parse_d( *line, end, &act_timestamp );
 	if ( *line == NULL )
 	{
 		act_timestamp = -1;
@@ -269,9 +772,9 @@ bool DTrackParser::parseLine_ts(char **line)
 /*
  * Parses a single line of additional information about number of calibrated bodies in one tracking data packet.
  */
-bool DTrackParser::parseLine_6dcal(char **line)
+bool DTrackParser::parseLine_6dcal( const char** line, const char* end )
 {
-	*line = string_get_i( *line, &loc_num_bodycal );
+	*line = string_parse_i( *line, end, &loc_num_bodycal );
 	if ( *line == 0 )
 		return false;
 	
@@ -282,29 +785,43 @@ bool DTrackParser::parseLine_6dcal(char **line)
 /*
  * Parses a single line of standard body data in one tracking data packet.
  */
-bool DTrackParser::parseLine_6d(char **line)
+bool DTrackParser::parseLine_6d( const char** line, const char* end )
 {
 	int i, j, n, id;
 	double d;
 	
-	// disable all existing data
-	for (i=0; i<act_num_body; i++) {
-		memset(&act_body[i], 0, sizeof(DTrack_Body_Type_d));
-		act_body[i].id = i;
-		act_body[i].quality = -1;
+	// disable data of bodies tracked in the frame before
+	for (i=0; i<(int )act_body_changes.tracked.size(); i++) {
+		id = act_body_changes.tracked[i];
+		memset(&act_body[id], 0, sizeof(DTrack_Body_Type_d));
+		act_body[id].id = id;
+		act_body[id].quality = -1;
 	}
+	act_body_changes.startLine();
 
 	// get number of standard bodies (in line)
-	*line = string_get_i( *line, &n );
+	*line = string_parse_i( *line, end, &n );
 	if ( *line == NULL )
 		return false;
 
 	// get data of standard bodies
 	for (i=0; i<n; i++) {
-		*line = string_get_block( *line, "id", &id, NULL, &d );
+		*line = string_get_block< int, 1, double, 1 >( *line, end, &id, &d );
 		if ( *line == NULL )
 			return false;
 
+		if (id < 0)  // not expected
+			return false;
+
+		if (!isBodySubscribed(id)) {  // skip location and rotation without parsing
+			loc_body_skipped.fetch_add( 1, std::memory_order_relaxed );
+			*line = string_skip_blocks( *line, end, 2 );
+			if ( *line == NULL )
+				return false;
+
+			continue;
+		}
+
 		// adjust length of vector
 		if (id >= act_num_body) {
 			act_body.resize(id + 1);
@@ -317,12 +834,13 @@ bool DTrackParser::parseLine_6d(char **line)
 		}
 		act_body[id].id = id;
 		act_body[id].quality = d;
+		act_body_changes.add(id);
 
-		*line = string_get_block( *line, "ddd", NULL, NULL, act_body[ id ].loc );
+		*line = string_get_block< double, 3 >( *line, end, act_body[ id ].loc );
 		if ( *line == NULL )
 			return false;
 
-		*line = string_get_block( *line, "ddddddddd", NULL, NULL, act_body[ id ].rot );
+		*line = string_get_block< double, 9 >( *line, end, act_body[ id ].rot );
 		if ( *line == NULL )
 			return false;
 	}
@@ -333,13 +851,13 @@ bool DTrackParser::parseLine_6d(char **line)
 /*
  * Parses a single line of 6d covariance data in one tracking data packet.
  */
-bool DTrackParser::parseLine_6dcov(char **line)
+bool DTrackParser::parseLine_6dcov( const char** line, const char* end )
 {
 	int n, id;
 	double cov_reduced[21];
 
 	// get number of standard bodies (in line)
-	*line = string_get_i( *line, &n );
+	*line = string_parse_i( *line, end, &n );
 	if ( *line == NULL )
 		return false;
 
@@ -347,14 +865,23 @@ bool DTrackParser::parseLine_6dcov(char **line)
 	for ( int i = 0; i < n; i++ )
 	{
 		double covref[ 3 ];
-		*line = string_get_block( *line, "iddd", &id, NULL, covref );
+		*line = string_get_block( *line, end, "iddd", &id, NULL, covref );
 		if ( *line == NULL )
 			return false;
 
+		if ( id < 0 || id >= act_num_body || !isBodySubscribed( id ) )
+		{  // skip covariance without parsing
+			*line = string_skip_blocks( *line, end, 1 );
+			if ( *line == NULL )
+				return false;
+
+			continue;
+		}
+
 		for ( int j = 0; j < 3; j++ )
 			act_body[ id ].covref[ j ] = covref[ j ];
 
-		*line = string_get_block( *line, "ddddddddddddddddddddd", NULL, NULL, cov_reduced );
+		*line = string_get_block( *line, end, "ddddddddddddddddddddd", NULL, NULL, cov_reduced );
 		if ( *line == NULL )
 			return false;
 
@@ -367,13 +894,13 @@ bool DTrackParser::parseLine_6dcov(char **line)
 /*
  * Parses a single line of Flystick data (older format) data in one tracking data packet.
  */
-bool DTrackParser::parseLine_6df(char **line)
+bool DTrackParser::parseLine_6df( const char** line, const char* end )
 {
 	int i, j, k, n, iarr[2];
 	double d;
 	
 	// get number of calibrated Flysticks
-	*line = string_get_i( *line, &n );
+	*line = string_parse_i( *line, end, &n );
 	if ( *line == NULL )
 		return false;
 
@@ -385,7 +912,7 @@ bool DTrackParser::parseLine_6df(char **line)
 	}
 	// get data of Flysticks
 	for (i=0; i<n; i++) {
-		*line = string_get_block( *line, "idi", iarr, NULL, &d );
+		*line = string_get_block( *line, end, "idi", iarr, NULL, &d );
 		if ( *line == NULL )
 			return false;
 
@@ -417,11 +944,11 @@ bool DTrackParser::parseLine_6df(char **line)
 			act_flystick[i].joystick[1] = 0;
 		}
 
-		*line = string_get_block( *line, "ddd", NULL, NULL, act_flystick[ i ].loc );
+		*line = string_get_block( *line, end, "ddd", NULL, NULL, act_flystick[ i ].loc );
 		if ( *line == NULL )
 			return false;
 
-		*line = string_get_block( *line, "ddddddddd", NULL, NULL, act_flystick[ i ].rot );
+		*line = string_get_block( *line, end, "ddddddddd", NULL, NULL, act_flystick[ i ].rot );
 		if ( *line == NULL )
 			return false;
 	}
@@ -433,14 +960,14 @@ bool DTrackParser::parseLine_6df(char **line)
 /*
  * Parses a single line of Flystick data (newer format) data in one tracking data packet.
  */
-bool DTrackParser::parseLine_6df2(char **line)
+bool DTrackParser::parseLine_6df2( const char** line, const char* end )
 {
 	int i, j, k, l, n, iarr[3];
 	double d;
 	char sfmt[20];
 	
 	// get number of calibrated Flysticks
-	*line = string_get_i( *line, &n );
+	*line = string_parse_i( *line, end, &n );
 	if ( *line == NULL )
 		return false;
 
@@ -451,13 +978,13 @@ bool DTrackParser::parseLine_6df2(char **line)
 	}
 
 	// get number of Flysticks
-	*line = string_get_i( *line, &n );
+	*line = string_parse_i( *line, end, &n );
 	if ( *line == NULL )
 		return false;
 
 	// get data of Flysticks
 	for (i=0; i<n; i++) {
-		*line = string_get_block( *line, "idii", iarr, NULL, &d );
+		*line = string_get_block< int, 1, double, 1, int, 2 >( *line, end, iarr, &d, &iarr[ 1 ] );
 		if ( *line == NULL )
 			return false;
 
@@ -473,11 +1000,11 @@ bool DTrackParser::parseLine_6df2(char **line)
 		act_flystick[i].num_button = iarr[1];
 		act_flystick[i].num_joystick = iarr[2];
 
-		*line = string_get_block( *line, "ddd", NULL, NULL, act_flystick[ i ].loc );
+		*line = string_get_block< double, 3 >( *line, end, act_flystick[ i ].loc );
 		if ( *line == NULL )
 			return false;
 
-		*line = string_get_block( *line, "ddddddddd", NULL, NULL, act_flystick[ i ].rot );
+		*line = string_get_block< double, 9 >( *line, end, act_flystick[ i ].rot );
 		if ( *line == NULL )
 			return false;
 
@@ -495,7 +1022,7 @@ bool DTrackParser::parseLine_6df2(char **line)
 			j++;
 		}
 
-		*line = string_get_block( *line, sfmt, iarr, NULL, act_flystick[ i ].joystick );
+		*line = string_get_block( *line, end, sfmt, iarr, NULL, act_flystick[ i ].joystick );
 		if ( *line == NULL )
 			return false;
 
@@ -518,13 +1045,13 @@ bool DTrackParser::parseLine_6df2(char **line)
 /*
  * Parses a single line of Measurement Tool data (older format) in one tracking data packet.
  */
-bool DTrackParser::parseLine_6dmt(char **line)
+bool DTrackParser::parseLine_6dmt( const char** line, const char* end )
 {
 	int i, j, k, n, iarr[3];
 	double d;
 	
 	// get number of calibrated measurement tools
-	*line = string_get_i( *line, &n );
+	*line = string_parse_i( *line, end, &n );
 	if ( *line == NULL )
 		return false;
 
@@ -536,7 +1063,7 @@ bool DTrackParser::parseLine_6dmt(char **line)
 	}
 	// get data of measurement tools
 	for (i=0; i<n; i++) {
-		*line = string_get_block( *line, "idi", iarr, NULL, &d );
+		*line = string_get_block( *line, end, "idi", iarr, NULL, &d );
 		if ( *line == NULL )
 			return false;
 
@@ -559,11 +1086,11 @@ bool DTrackParser::parseLine_6dmt(char **line)
 		
 		act_meatool[i].tipradius = 0.0;
 
-		*line = string_get_block( *line, "ddd", NULL, NULL, act_meatool[ i ].loc );
+		*line = string_get_block( *line, end, "ddd", NULL, NULL, act_meatool[ i ].loc );
 		if ( *line == NULL )
 			return false;
 
-		*line = string_get_block( *line, "ddddddddd", NULL, NULL, act_meatool[ i ].rot );
+		*line = string_get_block( *line, end, "ddddddddd", NULL, NULL, act_meatool[ i ].rot );
 		if ( *line == NULL )
 			return false;
 
@@ -578,7 +1105,7 @@ bool DTrackParser::parseLine_6dmt(char **line)
 /*
  * Parses a single line of Measurement Tool data (newer format) data in one tracking data packet.
  */
-bool DTrackParser::parseLine_6dmt2(char **line)
+bool DTrackParser::parseLine_6dmt2( const char** line, const char* end )
 {
 	int i, j, k, l, n, iarr[2];
 	double darr[2];
@@ -586,11 +1113,11 @@ bool DTrackParser::parseLine_6dmt2(char **line)
 	double cov_reduced[6];
 
 	// get number of calibrated measurement tools
-	*line = string_get_i( *line, &n );
+	*line = string_parse_i( *line, end, &n );
 	if ( *line == NULL )
 		return false;
 
-	*line = string_get_i( *line, &n );
+	*line = string_parse_i( *line, end, &n );
 	if ( *line == NULL )
 		return false;
 
@@ -601,7 +1128,7 @@ bool DTrackParser::parseLine_6dmt2(char **line)
 	}
 	// get data of measurement tools
 	for (i=0; i<n; i++) {
-		*line = string_get_block( *line, "idid", iarr, NULL, darr );
+		*line = string_get_block( *line, end, "idid", iarr, NULL, darr );
 		if ( *line == NULL )
 			return false;
 
@@ -621,11 +1148,11 @@ bool DTrackParser::parseLine_6dmt2(char **line)
 		
 		act_meatool[i].tipradius = darr[1];
 
-		*line = string_get_block( *line, "ddd", NULL, NULL, act_meatool[ i ].loc );
+		*line = string_get_block( *line, end, "ddd", NULL, NULL, act_meatool[ i ].loc );
 		if ( *line == NULL )
 			return false;
 
-		*line = string_get_block( *line, "ddddddddd", NULL, NULL, act_meatool[ i ].rot );
+		*line = string_get_block( *line, end, "ddddddddd", NULL, NULL, act_meatool[ i ].rot );
 		if ( *line == NULL )
 			return false;
 
@@ -637,7 +1164,7 @@ bool DTrackParser::parseLine_6dmt2(char **line)
 			j += 32;
 		}
 
-		*line = string_get_block( *line, sfmt, iarr, NULL, NULL );
+		*line = string_get_block( *line, end, sfmt, iarr, NULL, NULL );
 		if ( *line == NULL )
 			return false;
 
@@ -652,7 +1179,7 @@ bool DTrackParser::parseLine_6dmt2(char **line)
 			}
 		}
 
-		*line = string_get_block( *line, "dddddd", NULL, NULL, cov_reduced );
+		*line = string_get_block( *line, end, "dddddd", NULL, NULL, cov_reduced );
 		if ( *line == NULL )
 			return false;
 
@@ -666,13 +1193,13 @@ bool DTrackParser::parseLine_6dmt2(char **line)
 /*
  * Parses a single line of Measurement Tool reference data in one tracking data packet.
  */
-bool DTrackParser::parseLine_6dmtr(char **line)
+bool DTrackParser::parseLine_6dmtr( const char** line, const char* end )
 {
 	int i, n, id;
 	double d;
 	
 	// get number of measurement references
-	*line = string_get_i( *line, &n );
+	*line = string_parse_i( *line, end, &n );
 	if ( *line == NULL )
 		return false;
 
@@ -690,13 +1217,13 @@ bool DTrackParser::parseLine_6dmtr(char **line)
 	}
 
 	// get number of calibrated measurement references
-	*line = string_get_i( *line, &n );
+	*line = string_parse_i( *line, end, &n );
 	if ( *line == NULL )
 		return false;
 
 	// get data of measurement references
 	for (i=0; i<n; i++) {
-		*line = string_get_block( *line, "id", &id, NULL, &d );
+		*line = string_get_block( *line, end, "id", &id, NULL, &d );
 		if ( *line == NULL )
 			return false;
 
@@ -705,11 +1232,11 @@ bool DTrackParser::parseLine_6dmtr(char **line)
 		}
 		act_mearef[id].quality = d;
 
-		*line = string_get_block( *line, "ddd", NULL, NULL, act_mearef[ id ].loc );
+		*line = string_get_block( *line, end, "ddd", NULL, NULL, act_mearef[ id ].loc );
 		if ( *line == NULL )
 			return false;
 
-		*line = string_get_block( *line, "ddddddddd", NULL, NULL, act_mearef[ id ].rot );
+		*line = string_get_block( *line, end, "ddddddddd", NULL, NULL, act_mearef[ id ].rot );
 		if ( *line == NULL )
 			return false;
 	}
@@ -721,9 +1248,9 @@ bool DTrackParser::parseLine_6dmtr(char **line)
 /*
  * Parses a single line of additional information about number of calibrated A.R.T. FINGERTRACKING hands in one tracking data packet.
  */
-bool DTrackParser::parseLine_glcal(char **line)
+bool DTrackParser::parseLine_glcal( const char** line, const char* end )
 {
-	*line = string_get_i( *line, &loc_num_handcal );  // get number of calibrated hands
+	*line = string_parse_i( *line, end, &loc_num_handcal );  // get number of calibrated hands
 	if ( *line == NULL )
 		return false;
 
@@ -734,30 +1261,35 @@ bool DTrackParser::parseLine_glcal(char **line)
 /*
  * Parses a single line of A.R.T. FINGERTRACKING hand data in one tracking data packet.
  */
-bool DTrackParser::parseLine_gl(char **line)
+bool DTrackParser::parseLine_gl( const char** line, const char* end )
 {
 	int i, j, n, iarr[3], id;
 	double d, darr[6];
 	
-	// disable all existing data
-	for (i=0; i<act_num_hand; i++) {
-		memset(&act_hand[i], 0, sizeof(DTrack_Hand_Type_d));
-		act_hand[i].id = i;
-		act_hand[i].quality = -1;
+	// disable data of hands tracked in the frame before
+	for (i=0; i<(int )act_hand_changes.tracked.size(); i++) {
+		id = act_hand_changes.tracked[i];
+		memset(&act_hand[id], 0, sizeof(DTrack_Hand_Type_d));
+		act_hand[id].id = id;
+		act_hand[id].quality = -1;
 	}
+	act_hand_changes.startLine();
 
 	// get number of hands (in line)
-	*line = string_get_i( *line, &n );
+	*line = string_parse_i( *line, end, &n );
 	if ( *line == NULL )
 		return false;
 
 	// get data of hands
 	for (i=0; i<n; i++) {
-		*line = string_get_block( *line, "idii", iarr, NULL, &d );
+		*line = string_get_block< int, 1, double, 1, int, 2 >( *line, end, iarr, &d, &iarr[ 1 ] );
 		if ( *line == NULL )
 			return false;
 
 		id = iarr[0];
+		if (id < 0)  // not expected
+			return false;
+
 		if (id >= act_num_hand) {  // adjust length of vector
 			act_hand.resize(id + 1);
 			for (j=act_num_hand; j<=id; j++) {
@@ -770,30 +1302,31 @@ bool DTrackParser::parseLine_gl(char **line)
 		act_hand[id].id = iarr[0];
 		act_hand[id].lr = iarr[1];
 		act_hand[id].quality = d;
+		act_hand_changes.add(id);
 		if (iarr[2] > DTRACKSDK_HAND_MAX_FINGER) {
 			return false;
 		}
 		act_hand[id].nfinger = iarr[2];
 
-		*line = string_get_block( *line, "ddd", NULL, NULL, act_hand[ id ].loc );
+		*line = string_get_block< double, 3 >( *line, end, act_hand[ id ].loc );
 		if ( *line == NULL )
 			return false;
 
-		*line = string_get_block( *line, "ddddddddd", NULL, NULL, act_hand[ id ].rot );
+		*line = string_get_block< double, 9 >( *line, end, act_hand[ id ].rot );
 		if ( *line == NULL )
 			return false;
 
 		// get data of fingers
 		for (j = 0; j < act_hand[id].nfinger; j++) {
-			*line = string_get_block( *line, "ddd", NULL, NULL, act_hand[ id ].finger[ j ].loc );
+			*line = string_get_block< double, 3 >( *line, end, act_hand[ id ].finger[ j ].loc );
 			if ( *line == NULL )
 				return false;
 
-			*line = string_get_block( *line, "ddddddddd", NULL, NULL, act_hand[ id ].finger[ j ].rot );
+			*line = string_get_block< double, 9 >( *line, end, act_hand[ id ].finger[ j ].rot );
 			if ( *line == NULL )
 				return false;
 
-			*line = string_get_block( *line, "dddddd", NULL, NULL, darr );
+			*line = string_get_block< double, 6 >( *line, end, darr );
 			if ( *line == NULL )
 				return false;
 
@@ -813,13 +1346,14 @@ bool DTrackParser::parseLine_gl(char **line)
 /*
  * Parses a single line of ART-Human model data in one tracking data packet.
  */
-bool DTrackParser::parseLine_6dj(char **line)
+bool DTrackParser::parseLine_6dj( const char** line, const char* end )
 {
-	int i, j, n, iarr[2], id;
-	double d, darr[6];
+	int i, j, n, iarr[2], id, num_joint;
+	double d;
+	DTrackHuman::DTrackJoint* joint;
 
 	// get number of calibrated human models
-	*line = string_get_i( *line, &n );
+	*line = string_parse_i( *line, end, &n );
 	if ( *line == NULL )
 		return false;
 
@@ -829,45 +1363,57 @@ bool DTrackParser::parseLine_6dj(char **line)
 		act_num_human = n;
 	}
 	for(i=0; i<act_num_human; i++){
-		memset(&act_human[i], 0, sizeof(DTrack_Human_Type_d));
 		act_human[i].id = i;
 		act_human[i].num_joints = 0;
+		act_human[i].joint = NULL;
 	}
 
 	// get number of human models
-	*line = string_get_i( *line, &n );
+	*line = string_parse_i( *line, end, &n );
 	if ( *line == NULL )
 		return false;
 
 	int id_human;
+	num_joint = 0;  // used entries of joint pool
 	for (i=0; i<n; i++) {
-		*line = string_get_block( *line, "ii", iarr, NULL,NULL );
+		*line = string_get_block< int, 2 >( *line, end, iarr );
 		if ( *line == NULL )
 			return false;
 
-		if (iarr[0] > act_num_human - 1) // not expected
+		if ((iarr[0] < 0) || (iarr[0] > act_num_human - 1)) // not expected
+			return false;
+		
+		if ((iarr[1] < 0) || (iarr[1] > DTRACKSDK_HUMAN_MAX_JOINTS))
 			return false;
 		
 		id_human = iarr[0];
 		act_human[id_human].id = iarr[0];
+		if (iarr[1] == 0)
+			continue;
+		
+		// joints of all human models are stored contiguously:
+		if (num_joint + iarr[1] > (int )act_human_joint.size())
+			resizeHumanJoints(num_joint + iarr[1]);
+		
+		act_human[id_human].joint = &act_human_joint[num_joint];
 		act_human[id_human].num_joints = iarr[1];
+		num_joint += iarr[1];
 		
 		for (j = 0; j < iarr[1]; j++){
-			*line = string_get_block( *line, "id", &id, NULL, &d );
+			joint = &act_human[id_human].joint[j];
+			
+			*line = string_get_block< int, 1, double, 1 >( *line, end, &id, &d );
 			if ( *line == NULL )
 				return false;
 
-			act_human[id_human].joint[j].id = id;
-			act_human[id_human].joint[j].quality = d;
+			joint->id = id;
+			joint->quality = d;
 
-			*line = string_get_block( *line, "dddddd", NULL, NULL, darr );
+			*line = string_get_block< double, 3, double, 3 >( *line, end, joint->loc, joint->ang );
 			if ( *line == NULL )
 				return false;
 
-			memcpy(act_human[id_human].joint[j].loc, &darr,  3*sizeof(double));
-			memcpy(act_human[id_human].joint[j].ang, &darr[3],  3*sizeof(double));
-
-			*line = string_get_block( *line, "ddddddddd", NULL, NULL, act_human[ id_human ].joint[ j ].rot );
+			*line = string_get_block< double, 9 >( *line, end, joint->rot );
 			if ( *line == NULL )
 				return false;
 		}
@@ -877,35 +1423,63 @@ bool DTrackParser::parseLine_6dj(char **line)
 }
 
 
+/*
+ * Enlarges the pool of ART-Human joints.
+ */
+void DTrackParser::resizeHumanJoints( int num )
+{
+	int i;
+	std::vector< int > first( act_num_human, -1 );
+	
+	// remember position of already parsed joints, as the pool may be moved
+	for (i=0; i<act_num_human; i++) {
+		if (act_human[i].joint != NULL)
+			first[i] = (int )(act_human[i].joint - &act_human_joint[0]);
+	}
+	
+	act_human_joint.resize(num);
+	
+	for (i=0; i<act_num_human; i++) {
+		if (first[i] >= 0)
+			act_human[i].joint = &act_human_joint[first[i]];
+	}
+}
+
+
 /*
  * Parses a single line of hybrid (optical-inertial) body data in one tracking data packet.
  */
-bool DTrackParser::parseLine_6di(char **line)
+bool DTrackParser::parseLine_6di( const char** line, const char* end )
 {
 	int i, j, n, iarr[2], id, st;
 	double d;
 	
-	// disable all existing data
-	for (i=0; i<act_num_inertial; i++) {
-		memset(&act_inertial[i], 0, sizeof(DTrack_Inertial_Type_d));
-		act_inertial[i].id = i;
-		act_inertial[i].st = 0;
-		act_inertial[i].error = 0;
+	// disable data of bodies tracked in the frame before
+	for (i=0; i<(int )act_inertial_changes.tracked.size(); i++) {
+		id = act_inertial_changes.tracked[i];
+		memset(&act_inertial[id], 0, sizeof(DTrack_Inertial_Type_d));
+		act_inertial[id].id = id;
+		act_inertial[id].st = 0;
+		act_inertial[id].error = 0;
 	}
+	act_inertial_changes.startLine();
 
 	// get number of calibrated inertial bodies
-	*line = string_get_i( *line, &n );
+	*line = string_parse_i( *line, end, &n );
 	if ( *line == NULL )
 		return false;
 
 	// get data of inertial bodies
 	for (i=0; i<n; i++) {
-		*line = string_get_block( *line, "iid", iarr, NULL, &d );
+		*line = string_get_block< int, 2, double, 1 >( *line, end, iarr, &d );
 		if ( *line == NULL )
 			return false;
 
 		id = iarr[0];
 		st = iarr[1];
+		if (id < 0)  // not expected
+			return false;
+
 		// adjust length of vector
 		if (id >= act_num_inertial) {
 			act_inertial.resize(id + 1);
@@ -920,12 +1494,13 @@ bool DTrackParser::parseLine_6di(char **line)
 		act_inertial[id].id = id;
 		act_inertial[id].st = st;
 		act_inertial[id].error = d;
+		act_inertial_changes.add(id);
 
-		*line = string_get_block( *line, "ddd", NULL, NULL, act_inertial[ id ].loc );
+		*line = string_get_block< double, 3 >( *line, end, act_inertial[ id ].loc );
 		if ( *line == NULL )
 			return false;
 
-		*line = string_get_block( *line, "ddddddddd", NULL, NULL, act_inertial[ id ].rot );
+		*line = string_get_block< double, 9 >( *line, end, act_inertial[ id ].rot );
 		if ( *line == NULL )
 			return false;
 	}
@@ -937,12 +1512,12 @@ bool DTrackParser::parseLine_6di(char **line)
 /*
  * Parses a single line of single marker data in one tracking data packet.
  */
-bool DTrackParser::parseLine_3d(char **line)
+bool DTrackParser::parseLine_3d( const char** line, const char* end )
 {
 	int i;
 
 	// get number of markers
-	*line = string_get_i( *line, &act_num_marker );
+	*line = string_parse_i( *line, end, &act_num_marker );
 	if ( *line == NULL )
 	{
 		act_num_marker = 0;
@@ -954,11 +1529,11 @@ bool DTrackParser::parseLine_3d(char **line)
 
 	// get data of single markers
 	for (i=0; i<act_num_marker; i++) {
-		*line = string_get_block( *line, "id", &act_marker[ i ].id, NULL, &act_marker[ i ].quality );
+		*line = string_get_block( *line, end, "id", &act_marker[ i ].id, NULL, &act_marker[ i ].quality );
 		if ( *line == NULL )
 			return false;
 
-		*line = string_get_block( *line, "ddd", NULL, NULL, act_marker[ i ].loc );
+		*line = string_get_block( *line, end, "ddd", NULL, NULL, act_marker[ i ].loc );
 		if ( *line == NULL )
 			return false;
 	}
@@ -987,6 +1562,26 @@ const DTrackBody* DTrackParser::getBody( int id ) const
 }
 
 
+/*
+ * Get number of standard bodies, that changed in last received frame.
+ */
+int DTrackParser::getNumChangedBody() const
+{
+	return (int )act_body_changes.changed.size();
+}
+
+
+/*
+ * Get data of a standard body, that changed in last received frame.
+ */
+const DTrackBody* DTrackParser::getChangedBody( int index ) const
+{
+	if ((index >= 0) && (index < (int )act_body_changes.changed.size()))
+		return getBody(act_body_changes.changed[index]);
+	return NULL;
+}
+
+
 /*
  * Get number of calibrated Flysticks.
  */
@@ -1067,6 +1662,26 @@ const DTrackHand* DTrackParser::getHand( int id ) const
 }
 
 
+/*
+ * Get number of A.R.T. FINGERTRACKING hands, that changed in last received frame.
+ */
+int DTrackParser::getNumChangedHand() const
+{
+	return (int )act_hand_changes.changed.size();
+}
+
+
+/*
+ * Get data of an A.R.T. FINGERTRACKING hand, that changed in last received frame.
+ */
+const DTrackHand* DTrackParser::getChangedHand( int index ) const
+{
+	if ((index >= 0) && (index < (int )act_hand_changes.changed.size()))
+		return getHand(act_hand_changes.changed[index]);
+	return NULL;
+}
+
+
 /*
  * Get number of calibrated ART-Human models.
  */
@@ -1107,6 +1722,26 @@ const DTrackInertial* DTrackParser::getInertial( int id ) const
 }
 
 
+/*
+ * Get number of hybrid (optical-inertial) bodies, that changed in last received frame.
+ */
+int DTrackParser::getNumChangedInertial() const
+{
+	return (int )act_inertial_changes.changed.size();
+}
+
+
+/*
+ * Get data of a hybrid (optical-inertial) body, that changed in last received frame.
+ */
+const DTrackInertial* DTrackParser::getChangedInertial( int index ) const
+{
+	if ((index >= 0) && (index < (int )act_inertial_changes.changed.size()))
+		return getInertial(act_inertial_changes.changed[index]);
+	return NULL;
+}
+
+
 /*
  * Get number of tracked single markers.
  */
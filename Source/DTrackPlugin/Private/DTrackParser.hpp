@@ -38,7 +38,9 @@
 #define _ART_DTRACKSDK_PARSER_HPP_
 
 #include "DTrackDataTypes.hpp"
+#include "DTrackFrameBuffer.hpp"
 
+#include <atomic>
 #include <vector>
 
 using namespace DTrackSDK_Datatypes;
@@ -48,6 +50,40 @@ using namespace DTrackSDK_Datatypes;
  */
 class DTrackParser
 {
+public:
+
+	//! Types of lines in tracking data packets
+	typedef enum {
+		LINE_UNKNOWN = 0,  //!< Unknown line identifier (ignored)
+		LINE_FR,           //!< Frame counter ('fr')
+		LINE_TS,           //!< Timestamp ('ts')
+		LINE_6DCAL,        //!< Number of calibrated bodies ('6dcal')
+		LINE_6D,           //!< Standard bodies ('6d')
+		LINE_6DCOV,        //!< Covariance of standard bodies ('6dcov')
+		LINE_6DF,          //!< Flysticks, older format ('6df')
+		LINE_6DF2,         //!< Flysticks, newer format ('6df2')
+		LINE_6DMT,         //!< Measurement Tools, older format ('6dmt')
+		LINE_6DMT2,        //!< Measurement Tools, newer format ('6dmt2')
+		LINE_6DMTR,        //!< Measurement Tool references ('6dmtr')
+		LINE_GLCAL,        //!< Number of calibrated Fingertracking hands ('glcal')
+		LINE_GL,           //!< Fingertracking hands ('gl')
+		LINE_6DJ,          //!< ART-Human models ('6dj')
+		LINE_6DI,          //!< Hybrid (optical-inertial) bodies ('6di')
+		LINE_3D,           //!< Single markers ('3d')
+		LINE_NUM           //!< Number of line types
+	} LineType;
+
+	//! Bit mask of all line types (see setSubscribedLineTypes())
+	static const unsigned int LINE_MASK_ALL = 0xffffffff;
+
+	/**
+	 * \brief Get bit of a line type within a line type mask.
+	 *
+	 * @param[in] type Line type
+	 * @return         Bit mask of line type
+	 */
+	static unsigned int getLineTypeBit( LineType type )  { return 1u << type; }
+
 protected:
 
 	/**
@@ -76,12 +112,167 @@ protected:
 	 * Updates internal data structures.
 	 *
 	 * @param[in,out] line One line of data in one tracking data packet
+	 * @param[in]     end  End of tracking data packet (behind last character)
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine( char **line );
+	bool parseLine( const char** line, const char* end );
+
+	/**
+	 * \brief Parses all lines of one tracking data packet.
+	 *
+	 * Finds the begin and type of all lines first (see string_index_lines()), then parses them.
+	 * Updates internal data structures.
+	 *
+	 * @param[in] data Begin of tracking data packet
+	 * @param[in] end  End of tracking data packet (behind last character)
+	 * @return         Parsing succeeded?
+	 */
+	bool parsePacket( const char* data, const char* end );
 
 public:
 
+	/**
+	 * \brief Get number of parsed lines of one type.
+	 *
+	 * Counts all lines since creation (or last call of resetLineCounters()), including lines
+	 * that could not be parsed or were skipped (see setSubscribedLineTypes()). Intended for
+	 * monitoring which data DTrack is sending; may be called while another thread is receiving.
+	 *
+	 * @param[in] type Line type
+	 * @return         Number of parsed lines
+	 */
+	unsigned int getNumParsedLines( LineType type ) const;
+
+	/**
+	 * \brief Get number of lines of one type, that could not be parsed.
+	 *
+	 * @param[in] type Line type
+	 * @return         Number of parsing errors
+	 */
+	unsigned int getNumParseErrors( LineType type ) const;
+
+	/**
+	 * \brief Reset counters of parsed lines and parsing errors.
+	 */
+	void resetLineCounters();
+
+	/**
+	 * \brief Set line types, that should be parsed.
+	 *
+	 * Lines of other types are skipped directly after determining their type. Data provided by
+	 * these line types is reset and not updated anymore. Frame counter, timestamp and numbers of
+	 * calibrated bodies and hands ('fr', 'ts', '6dcal', 'glcal') are always parsed.
+	 *
+	 * @param[in] mask Bit mask of line types (see getLineTypeBit()); LINE_MASK_ALL for all (default)
+	 */
+	void setSubscribedLineTypes( unsigned int mask );
+
+	/**
+	 * \brief Get line types, that are parsed.
+	 *
+	 * @return Bit mask of line types (see getLineTypeBit())
+	 */
+	unsigned int getSubscribedLineTypes() const;
+
+	/**
+	 * \brief Set ids of standard bodies, that should be parsed.
+	 *
+	 * Records of other bodies in '6d' and '6dcov' lines are skipped without parsing their values,
+	 * so they are never reported as changed and keep quality -1. Intended for several receivers of
+	 * one data stream (e.g. multicast), each of them needing just a few bodies.
+	 *
+	 * @param[in] ids Ids of standard bodies, range 0 ..; empty for all bodies (default)
+	 */
+	void setSubscribedBodies( const std::vector< int >& ids );
+
+	/**
+	 * \brief Get if a standard body is parsed.
+	 *
+	 * @param[in] id Id, range 0 ..
+	 * @return       Standard body is parsed?
+	 */
+	bool isBodySubscribed( int id ) const;
+
+	/**
+	 * \brief Get number of standard body records, that were skipped as not subscribed.
+	 *
+	 * Counts all records since creation (or last call of resetLineCounters()).
+	 *
+	 * @return Number of skipped standard body records
+	 */
+	unsigned int getNumSkippedBodies() const;
+
+	/**
+	 * \brief Get name of a line type.
+	 *
+	 * @param[in] type Line type
+	 * @return         Line identifier without trailing space (e.g. '6d'), 'unknown' for LINE_UNKNOWN
+	 */
+	static const char* getLineTypeName( LineType type );
+
+	/**
+	 * \brief Enable filling of pose arrays at the end of each frame.
+	 *
+	 * Disabled by default.
+	 *
+	 * @param[in] enable Enable pose arrays?
+	 */
+	void setPoseArraysEnabled( bool enable );
+
+	/**
+	 * \brief Get if pose arrays are filled at the end of each frame.
+	 *
+	 * @return Pose arrays enabled?
+	 */
+	bool isPoseArraysEnabled() const;
+
+	/**
+	 * \brief Get poses of standard bodies, as structure of arrays.
+	 *
+	 * Refers to last received frame. Contains the changed standard bodies (see getChangedBody()),
+	 * if pose arrays are enabled (see setPoseArraysEnabled()).
+	 *
+	 * @return Poses of standard bodies
+	 */
+	const DTrackPoseArrays& getBodyPoseArrays() const;
+
+	/**
+	 * \brief Get poses of Flysticks, as structure of arrays.
+	 *
+	 * Refers to last received frame. Contains all calibrated Flysticks, if pose arrays are enabled
+	 * (see setPoseArraysEnabled()).
+	 *
+	 * @return Poses of Flysticks
+	 */
+	const DTrackPoseArrays& getFlyStickPoseArrays() const;
+
+	/**
+	 * \brief Get poses of hybrid (optical-inertial) bodies, as structure of arrays.
+	 *
+	 * Refers to last received frame. Contains the changed hybrid bodies (see getChangedInertial()),
+	 * if pose arrays are enabled (see setPoseArraysEnabled()). Quality is 1.0 if tracked, else -1.0.
+	 *
+	 * @return Poses of hybrid bodies
+	 */
+	const DTrackPoseArrays& getInertialPoseArrays() const;
+
+	/**
+	 * \brief Set buffer, where each frame is published at its end.
+	 *
+	 * Allows other threads to read the latest complete frame (see DTrackFrameBuffer::acquireLatest()),
+	 * while the next one is parsed. The buffer is not owned by the parser.
+	 *
+	 * @param[in] buffer Frame buffer; NULL to disable publishing (default)
+	 */
+	void setFrameBuffer( DTrackFrameBuffer* buffer );
+
+	/**
+	 * \brief Get buffer, where each frame is published at its end.
+	 *
+	 * @return Frame buffer; NULL if disabled
+	 */
+	DTrackFrameBuffer* getFrameBuffer() const;
+
 	/**
 	 * \brief Get frame counter.
 	 *
@@ -119,6 +310,25 @@ public:
 	 */
 	const DTrackBody* getBody( int id ) const;
 
+	/**
+	 * \brief Get number of standard bodies, that changed in last received frame.
+	 *
+	 * Includes bodies, that are tracked, and bodies, that were tracked in the frame before.
+	 *
+	 * @return Number of changed standard bodies
+	 */
+	int getNumChangedBody() const;
+
+	/**
+	 * \brief Get data of a standard body, that changed in last received frame.
+	 *
+	 * Untracked bodies are reported once, having quality -1.
+	 *
+	 * @param[in] index Index, range 0 .. getNumChangedBody() - 1
+	 * @return          I-th changed standard body data; NULL in case of error
+	 */
+	const DTrackBody* getChangedBody( int index ) const;
+
 	/**
 	 * \brief Get number of calibrated Flysticks.
 	 *
@@ -195,6 +405,25 @@ public:
 	 */
 	const DTrackHand* getHand( int id ) const;
 
+	/**
+	 * \brief Get number of A.R.T. FINGERTRACKING hands, that changed in last received frame.
+	 *
+	 * Includes hands, that are tracked, and hands, that were tracked in the frame before.
+	 *
+	 * @return Number of changed A.R.T. FINGERTRACKING hands
+	 */
+	int getNumChangedHand() const;
+
+	/**
+	 * \brief Get data of an A.R.T. FINGERTRACKING hand, that changed in last received frame.
+	 *
+	 * Untracked hands are reported once, having quality -1.
+	 *
+	 * @param[in] index Index, range 0 .. getNumChangedHand() - 1
+	 * @return          I-th changed A.R.T. FINGERTRACKING hand data; NULL in case of error
+	 */
+	const DTrackHand* getChangedHand( int index ) const;
+
 	/**
 	 * \brief Get number of calibrated ART-Human models.
 	 *
@@ -233,6 +462,25 @@ public:
 	 */
 	const DTrackInertial* getInertial( int id ) const;
 
+	/**
+	 * \brief Get number of hybrid (optical-inertial) bodies, that changed in last received frame.
+	 *
+	 * Includes bodies, that are tracked, and bodies, that were tracked in the frame before.
+	 *
+	 * @return Number of changed hybrid bodies
+	 */
+	int getNumChangedInertial() const;
+
+	/**
+	 * \brief Get data of a hybrid (optical-inertial) body, that changed in last received frame.
+	 *
+	 * Untracked bodies are reported once, having state 0.
+	 *
+	 * @param[in] index Index, range 0 .. getNumChangedInertial() - 1
+	 * @return          I-th changed inertial body data; NULL in case of error
+	 */
+	const DTrackInertial* getChangedInertial( int index ) const;
+
 	/**
 	 * \brief Get number of tracked single markers.
 	 *
@@ -254,15 +502,59 @@ public:
 
 private:
 
+	/**
+	 * \brief Fills pose arrays with the data of the current frame.
+	 */
+	void fillPoseArrays();
+
+	/**
+	 * \brief Copies the data of the current frame into the frame buffer.
+	 */
+	void publishFrame();
+
+	/**
+	 * \brief Determines the type of a line in one tracking data packet.
+	 *
+	 * @param[in] line Begin of line
+	 * @param[in] end  End of tracking data packet (behind last character)
+	 * @return         Type of line
+	 */
+	static LineType getLineType( const char* line, const char* end );
+
+	/**
+	 * \brief Parses a single line of data of known type in one tracking data packet.
+	 *
+	 * Updates internal data structures.
+	 *
+	 * @param[in]     type Type of line
+	 * @param[in,out] line One line of data in one tracking data packet (including identifier)
+	 * @param[in]     end  End of tracking data packet (behind last character)
+	 * @return             Parsing succeeded?
+	 */
+	bool parseLine( LineType type, const char** line, const char* end );
+
+	/**
+	 * \brief Skips a single line of an unsubscribed type in one tracking data packet.
+	 *
+	 * Parses just what is needed by other line types.
+	 *
+	 * @param[in]     type Type of line
+	 * @param[in,out] line One line of data in one tracking data packet (behind identifier)
+	 * @param[in]     end  End of tracking data packet (behind last character)
+	 * @return             Parsing succeeded?
+	 */
+	bool skipLine( LineType type, const char** line, const char* end );
+
 	/**
 	 * \brief Parses a single line of frame counter data in one tracking data packet.
 	 *
 	 * Updates internal data structures.
 	 *
 	 * @param[in,out] line Line of 'fr' data in one tracking data packet
+	 * @param[in]     end  End of tracking data packet (behind last character)
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_fr( char **line );
+	bool parseLine_fr( const char** line, const char* end );
 
 	/**
 	 * \brief Parses a single line of timestamp data in one tracking data packet.
@@ -270,9 +562,10 @@ private:
 	 * Updates internal data structures.
 	 *
 	 * @param[in,out] line Line of 'ts' data in one tracking data packet
+	 * @param[in]     end  End of tracking data packet (behind last character)
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_ts( char **line );
+	bool parseLine_ts( const char** line, const char* end );
 
 	/**
 	 * \brief Parses a single line of additional information about number of calibrated bodies in one tracking data packet.
@@ -280,9 +573,10 @@ private:
 	 * Updates internal data structures.
 	 *
 	 * @param[in,out] line Line of '6dcal' data in one tracking data packet
+	 * @param[in]     end  End of tracking data packet (behind last character)
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6dcal( char **line );
+	bool parseLine_6dcal( const char** line, const char* end );
 
 	/**
 	 * \brief Parses a single line of standard body data in one tracking data packet.
@@ -290,9 +584,10 @@ private:
 	 * Updates internal data structures.
 	 *
 	 * @param[in,out] line Line of '6d' data in one tracking data packet
+	 * @param[in]     end  End of tracking data packet (behind last character)
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6d( char **line );
+	bool parseLine_6d( const char** line, const char* end );
 
 	/**
 	 * \brief Parses a single line of 6d covariance data in one tracking data packet.
@@ -300,9 +595,10 @@ private:
 	 * Updates internal data structures.
 	 *
 	 * @param[in,out] line Line of '6dcov' data in one tracking data packet
+	 * @param[in]     end  End of tracking data packet (behind last character)
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6dcov( char **line );
+	bool parseLine_6dcov( const char** line, const char* end );
 
 	/**
 	 * \brief Parses a single line of Flystick data (older format) data in one tracking data packet.
@@ -310,9 +606,10 @@ private:
 	 * Updates internal data structures.
 	 *
 	 * @param[in,out] line Line of '6df' data in one tracking data packet
+	 * @param[in]     end  End of tracking data packet (behind last character)
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6df( char **line );
+	bool parseLine_6df( const char** line, const char* end );
 
 	/**
 	 * \brief Parses a single line of Flystick data (newer format) data in one tracking data packet.
@@ -320,9 +617,10 @@ private:
 	 * Updates internal data structures.
 	 *
 	 * @param[in,out] line Line of '6df2' data in one tracking data packet
+	 * @param[in]     end  End of tracking data packet (behind last character)
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6df2( char **line );
+	bool parseLine_6df2( const char** line, const char* end );
 
 	/**
 	 * \brief Parses a single line of Measurement Tool data (older format) in one tracking data packet.
@@ -330,9 +628,10 @@ private:
 	 * Updates internal data structures.
 	 *
 	 * @param[in,out] line Line of '6dmt' data in one tracking data packet
+	 * @param[in]     end  End of tracking data packet (behind last character)
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6dmt( char **line );
+	bool parseLine_6dmt( const char** line, const char* end );
 
 	/**
 	 * \brief Parses a single line of Measurement Tool data (newer format) data in one tracking data packet.
@@ -340,9 +639,10 @@ private:
 	 * Updates internal data structures.
 	 *
 	 * @param[in,out] line Line of '6dmt2' data in one tracking data packet
+	 * @param[in]     end  End of tracking data packet (behind last character)
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6dmt2( char **line );
+	bool parseLine_6dmt2( const char** line, const char* end );
 
 	/**
 	 * \brief Parses a single line of Measurement Tool reference data in one tracking data packet.
@@ -350,9 +650,10 @@ private:
 	 * Updates internal data structures.
 	 *
 	 * @param[in,out] line Line of '6dmtr' data in one tracking data packet
+	 * @param[in]     end  End of tracking data packet (behind last character)
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6dmtr( char **line );
+	bool parseLine_6dmtr( const char** line, const char* end );
 
 	/**
 	 * \brief Parses a single line of additional information about number of calibrated Fingertracking hands in one tracking data packet.
@@ -360,9 +661,10 @@ private:
 	 * Updates internal data structures.
 	 *
 	 * @param[in,out] line Line of 'glcal' data in one tracking data packet
+	 * @param[in]     end  End of tracking data packet (behind last character)
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_glcal( char **line );
+	bool parseLine_glcal( const char** line, const char* end );
 
 	/**
 	 * \brief Parses a single line of A.R.T. Fingertracking hand data in one tracking data packet.
@@ -370,9 +672,10 @@ private:
 	 * Updates internal data structures.
 	 *
 	 * @param[in,out] line Line of 'gl' data in one tracking data packet
+	 * @param[in]     end  End of tracking data packet (behind last character)
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_gl( char **line );
+	bool parseLine_gl( const char** line, const char* end );
 
 	/**
 	 * \brief Parses a single line of ART-Human model data in one tracking data packet.
@@ -380,9 +683,19 @@ private:
 	 * Updates internal data structures.
 	 *
 	 * @param[in,out] line Line of '6dj' data in one tracking data packet
+	 * @param[in]     end  End of tracking data packet (behind last character)
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6dj( char **line );
+	bool parseLine_6dj( const char** line, const char* end );
+
+	/**
+	 * \brief Enlarges the pool of ART-Human joints.
+	 *
+	 * Joint pointers of already parsed human models are kept valid.
+	 *
+	 * @param[in] num New number of joints in pool
+	 */
+	void resizeHumanJoints( int num );
 
 	/**
 	 * \brief Parses a single line of hybrid (optical-inertial) body data in one tracking data packet.
@@ -390,9 +703,10 @@ private:
 	 * Updates internal data structures.
 	 *
 	 * @param[in,out] line Line of '6di' data in one tracking data packet
+	 * @param[in]     end  End of tracking data packet (behind last character)
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6di( char **line );
+	bool parseLine_6di( const char** line, const char* end );
 
 	/**
 	 * \brief Parses a single line of single marker data in one tracking data packet.
@@ -400,9 +714,10 @@ private:
 	 * Updates internal data structures.
 	 *
 	 * @param[in,out] line Line of '3d' data in one tracking data packet
+	 * @param[in]     end  End of tracking data packet (behind last character)
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_3d(char **line);
+	bool parseLine_3d( const char** line, const char* end );
 
 private:
 
@@ -420,11 +735,76 @@ private:
 	std::vector< DTrackHand > act_hand;               //!< Array containing A.R.T. FINGERTRACKING hand data
 	int act_num_human;                                //!< Number of calibrated ART-Human models
 	std::vector< DTrackHuman > act_human;             //!< Array containing ART-Human model data
+	std::vector< DTrackHuman::DTrackJoint > act_human_joint;  //!< Array containing joint data of all ART-Human models
 	int act_num_inertial;                             //!< Number of calibrated hybrid (optical-inertial) bodies
 	std::vector< DTrackInertial > act_inertial;       //!< Array containing hybrid (optical-inertial) body data
 	int act_num_marker;                               //!< Number of tracked single markers
 	std::vector< DTrackMarker > act_marker;           //!< Array containing single marker data
 
+	/**
+	 * \brief Ids of records of one line type, that changed in the current frame.
+	 *
+	 * Allows to reset just the records of the frame before, instead of all calibrated ones.
+	 */
+	struct ChangeList
+	{
+		std::vector< int > tracked;               //!< Ids contained in last parsed line
+		std::vector< int > changed;               //!< Ids tracked now or in the frame before
+		std::vector< unsigned char > is_changed;  //!< Flags per id, if contained in 'changed'
+
+		/**
+		 * \brief Empties list at start of a new frame.
+		 */
+		void startFrame();
+
+		/**
+		 * \brief Marks ids of the frame before as changed, at start of parsing a new line.
+		 *
+		 * Data of these ids has to be reset by the caller before.
+		 */
+		void startLine();
+
+		/**
+		 * \brief Adds id of a record contained in the current line.
+		 *
+		 * @param[in] id Id of record
+		 */
+		void add( int id );
+
+		/**
+		 * \brief Removes all ids.
+		 */
+		void clear();
+	};
+
+	ChangeList act_body_changes;      //!< Changed standard bodies
+	ChangeList act_hand_changes;      //!< Changed A.R.T. FINGERTRACKING hands
+	ChangeList act_inertial_changes;  //!< Changed hybrid (optical-inertial) bodies
+
+	bool act_pose_arrays_enabled;               //!< Fill pose arrays at end of frame?
+	DTrackPoseArrays act_body_pose_arrays;      //!< Poses of changed standard bodies
+	DTrackPoseArrays act_flystick_pose_arrays;  //!< Poses of Flysticks
+	DTrackPoseArrays act_inertial_pose_arrays;  //!< Poses of changed hybrid (optical-inertial) bodies
+
+	DTrackFrameBuffer* act_frame_buffer;  //!< Buffer to publish frames (NULL if disabled)
+
+	/**
+	 * \brief Entry of line index of one tracking data packet.
+	 */
+	struct LineIndexEntry
+	{
+		int offset;     //!< Offset of begin of line within packet
+		LineType type;  //!< Type of line
+	};
+
+	std::vector< int > loc_line_offsets;             //!< internal use, begin of lines in current packet
+	std::vector< LineIndexEntry > loc_line_index;    //!< internal use, line index of current packet
+	unsigned int loc_line_mask;                       //!< internal use, line types to be parsed
+	std::atomic< unsigned int > loc_line_count[ LINE_NUM ];   //!< internal use, number of parsed lines per line type
+	std::atomic< unsigned int > loc_line_errors[ LINE_NUM ];  //!< internal use, number of parsing errors per line type
+	std::vector< unsigned char > loc_body_filter;     //!< internal use, flags per standard body id, if parsed (empty for all)
+	std::atomic< unsigned int > loc_body_skipped;     //!< internal use, number of skipped standard body records
+
 	int loc_num_bodycal;    //!< internal use, local number of calibrated bodies
 	int loc_num_handcal;    //!< internal use, local number of hands
 	int loc_num_flystick1;  //!< internal use, local number of old flysticks
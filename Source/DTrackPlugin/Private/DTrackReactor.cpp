@@ -0,0 +1,152 @@
+/* DTrackReactor: C++ source file
+ *
+ * DTrackSDK: receiving tracking data of several sources in one thread.
+ *
+ * Copyright 2021, Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Version v2.7.0
+ * 
+ */
+
+
+#include "DTrackReactor.hpp"
+
+#include <cstddef>
+
+
+/*
+ * Constructor.
+ */
+DTrackReactor::DTrackReactor()
+{
+	for (int i=0; i<DTrackNet::UDP::MAX_WAIT_SOCKETS; i++)
+		ready[i] = false;
+}
+
+
+/*
+ * Destructor.
+ */
+DTrackReactor::~DTrackReactor()
+{
+	//
+}
+
+
+/*
+ * Add a source of tracking data.
+ */
+int DTrackReactor::addSource( DTrackSDK* sdk )
+{
+	if (sdk == NULL || sdk->d_udp == NULL || !sdk->isDataInterfaceValid())
+		return -1;
+	
+	if ((int )sources.size() >= DTrackNet::UDP::MAX_WAIT_SOCKETS)
+		return -1;
+	
+	sources.push_back(sdk);
+	sockets.push_back(sdk->d_udp);
+	return (int )sources.size() - 1;
+}
+
+
+/*
+ * Remove all sources.
+ */
+void DTrackReactor::removeAllSources()
+{
+	sources.clear();
+	sockets.clear();
+}
+
+
+/*
+ * Get number of sources.
+ */
+int DTrackReactor::getNumSources() const
+{
+	return (int )sources.size();
+}
+
+
+/*
+ * Get source.
+ */
+DTrackSDK* DTrackReactor::getSource( int index ) const
+{
+	if (index < 0 || index >= (int )sources.size())
+		return NULL;
+	
+	return sources[index];
+}
+
+
+/*
+ * Wait until tracking data is available for at least one source.
+ */
+int DTrackReactor::wait( int timeoutUs )
+{
+	int i, n;
+	
+	n = (int )sources.size();
+	if (n == 0)
+		return -2;
+	
+	// data already fetched, but not processed: no need to wait
+	int num = 0;
+	for (i=0; i<n; i++) {
+		ready[i] = sources[i]->hasPendingData();
+		if (ready[i])
+			num++;
+	}
+	
+	if (num > 0)
+		return num;
+	
+	return DTrackNet::UDP::waitForAny(&sockets[0], n, timeoutUs, ready);
+}
+
+
+/*
+ * Returns if tracking data is available for a source after wait().
+ */
+bool DTrackReactor::isReady( int index ) const
+{
+	if (index < 0 || index >= (int )sources.size())
+		return false;
+	
+	return ready[index];
+}
+
+
+/*
+ * Interrupt waiting for tracking data.
+ */
+void DTrackReactor::interrupt()
+{
+	for (size_t i=0; i<sources.size(); i++)
+		sources[i]->interruptReceive();
+}
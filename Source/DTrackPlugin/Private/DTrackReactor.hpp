@@ -0,0 +1,135 @@
+/* DTrackReactor: C++ header file
+ *
+ * DTrackSDK: receiving tracking data of several sources in one thread.
+ *
+ * Copyright 2021, Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Version v2.7.0
+ * 
+ */
+
+#ifndef _ART_DTRACKSDK_REACTOR_HPP_
+#define _ART_DTRACKSDK_REACTOR_HPP_
+
+#include "DTrackSDK.hpp"
+
+#include <vector>
+
+/**
+ * \brief Receiving tracking data of several sources (e.g. several Controllers) in one thread.
+ *
+ * Waits with one system call for the UDP sockets of all added DTrackSDK instances. Each instance keeps
+ * parsing its own data, and its own settings (e.g. backlog policy).
+ *
+ * Usage:
+ * \code
+ *   while ( reactor.wait( timeoutUs ) > 0 )
+ *     for ( int i = 0; i < reactor.getNumSources(); i++ )
+ *       if ( reactor.isReady( i ) && reactor.getSource( i )->receiveAvailable() )
+ *         ... // process data of source i
+ * \endcode
+ */
+class DTrackReactor
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 */
+	DTrackReactor();
+
+	/**
+	 * \brief Destructor.
+	 */
+	~DTrackReactor();
+
+	/**
+	 * \brief Add a source of tracking data.
+	 *
+	 * The instance is not owned by the reactor; it has to stay valid until removeAllSources().
+	 *
+	 * @param[in] sdk Instance, receiving tracking data by UDP
+	 * @return        Index of source, -1 if too many sources or no valid data interface
+	 */
+	int addSource( DTrackSDK* sdk );
+
+	/**
+	 * \brief Remove all sources.
+	 */
+	void removeAllSources();
+
+	/**
+	 * \brief Get number of sources.
+	 *
+	 * @return Number of sources
+	 */
+	int getNumSources() const;
+
+	/**
+	 * \brief Get source.
+	 *
+	 * @param[in] index Index of source
+	 * @return          Instance, NULL if not available
+	 */
+	DTrackSDK* getSource( int index ) const;
+
+	/**
+	 * \brief Wait until tracking data is available for at least one source.
+	 *
+	 * Returns at once, if data was already fetched but not processed (see DTrackSDK::hasPendingData()).
+	 *
+	 * @param[in] timeoutUs Timeout in us (micro seconds)
+	 * @return              Number of sources with data available, -1 timeout, -2 error, -5 interrupted
+	 */
+	int wait( int timeoutUs );
+
+	/**
+	 * \brief Returns if tracking data is available for a source after wait().
+	 *
+	 * @param[in] index Index of source
+	 * @return          Data available?
+	 */
+	bool isReady( int index ) const;
+
+	/**
+	 * \brief Interrupt waiting for tracking data.
+	 *
+	 * Interrupts all sources (see DTrackSDK::interruptReceive()). Can be called from any thread.
+	 */
+	void interrupt();
+
+private:
+
+	DTrackReactor( const DTrackReactor& );             // not copyable
+	DTrackReactor& operator=( const DTrackReactor& );
+
+	std::vector< DTrackSDK* > sources;          //!< Sources of tracking data
+	std::vector< DTrackNet::UDP* > sockets;     //!< UDP sockets of sources
+	bool ready[ DTrackNet::UDP::MAX_WAIT_SOCKETS ];  //!< Data available, per source
+};
+
+
+#endif  // _ART_DTRACKSDK_REACTOR_HPP_
@@ -44,12 +44,9 @@
 
 #include <cstring>
 #include <cstdlib>
-#include <clocale>
 
 #if defined( _MSC_VER )
 	#define strdup _strdup  // use Visual Studio specific method to avoid warnings
-#else
-	#define strcpy_s( a, b, c )  strcpy( a, c )  // map 'strcpy_s' if not Visual Studio
 #endif
 
 using namespace DTrackNet;
@@ -148,14 +145,22 @@ DTrackSDK::DTrackSDK(const std::string& server_host, unsigned short server_port,
 void DTrackSDK::init( const std::string& server_host, unsigned short server_port, unsigned short data_port,
                       RemoteSystemType remote_type )
 {
-	setlocale( LC_NUMERIC, "C" );
-
 	rsType = remote_type;
 
 	d_udp = NULL;
 	d_tcp = NULL;
 	d_udpbuf = NULL;
 	d_udpbufsize = 0;
+	d_udplen = 0;
+	d_udpbufsize_max = DEFAULT_UDP_BUFSIZE_MAX;
+	d_udp_maxpacket = 0;
+	d_udp_truncated = 0;
+	
+	d_backlog_policy = BACKLOG_NEWEST_ONLY;
+	d_backlog_max = 1;
+	d_backlog_first = d_backlog_num = 0;
+	d_backlog_dropped = 0;
+	d_receive_timestamp = 0.0;
 	
 	lastDataError = ERR_NONE;
 	lastServerError = ERR_NONE;
@@ -230,9 +235,12 @@ void DTrackSDK::init( const std::string& server_host, unsigned short server_port
  */
 DTrackSDK::~DTrackSDK()
 {
-	// release buffer
+	// release buffers
 	free(d_udpbuf);
 	
+	for (size_t i = 0; i < d_backlog_buf.size(); i++)
+		free(d_backlog_buf[i]);
+	
 	// release sockets & net
 	delete d_udp;
 	delete d_tcp;
@@ -322,7 +330,8 @@ bool DTrackSDK::setDataBufferSize( int bufSize )
 	int newBufSize;
 	if ( bufSize <= 0 )
 	{
-		newBufSize = DEFAULT_UDP_BUFSIZE;
+		// smaller, if growDataBuffer() gets the real size of a packet that did not fit
+		newBufSize = UDP::isTruncatedSizeKnown() ? DEFAULT_UDP_BUFSIZE_TRUNC : DEFAULT_UDP_BUFSIZE;
 	}
 	else
 	{
@@ -335,17 +344,396 @@ bool DTrackSDK::setDataBufferSize( int bufSize )
 
 		d_udpbufsize = newBufSize;
 		d_udpbuf = (char *)malloc( d_udpbufsize );
+		d_udplen = 0;
+		if ( d_udpbuf != NULL )
+			d_udpbuf[ 0 ] = '\0';
+
+		if ( d_backlog_policy == BACKLOG_BOUNDED )
+			resizeBacklog();
 	}
 	return ( d_udpbuf != NULL );
 }
 
 
+/*
+ * Set handling of tracking data packets, that queued up between two calls of receive().
+ */
+bool DTrackSDK::setBacklogPolicy( BacklogPolicy policy, int maxPackets )
+{
+	if ( policy == BACKLOG_BOUNDED && maxPackets < 1 )
+		return false;
+
+	d_backlog_policy = policy;
+	d_backlog_max = ( policy == BACKLOG_BOUNDED ) ? maxPackets : 1;
+
+	resizeBacklog();
+	return true;
+}
+
+
+/*
+ * Get handling of tracking data packets, that queued up between two calls of receive().
+ */
+DTrackSDK::BacklogPolicy DTrackSDK::getBacklogPolicy() const
+{
+	return d_backlog_policy;
+}
+
+
+/*
+ * Get number of tracking data packets, that were dropped due to the backlog policy.
+ */
+unsigned int DTrackSDK::getNumDroppedPackets() const
+{
+	return d_backlog_dropped;
+}
+
+
+/*
+ * Reset number of dropped tracking data packets.
+ */
+void DTrackSDK::resetNumDroppedPackets()
+{
+	d_backlog_dropped = 0;
+}
+
+
+/*
+ * Get number of received tracking data packets.
+ */
+unsigned int DTrackSDK::getNumReceivedPackets() const
+{
+	if ( d_udp == NULL )  return 0;
+
+	return d_udp->getNumReceivedPackets();
+}
+
+
+/*
+ * Get number of system calls needed to receive tracking data packets.
+ */
+unsigned int DTrackSDK::getNumReceiveSyscalls() const
+{
+	if ( d_udp == NULL )  return 0;
+
+	return d_udp->getNumReceiveSyscalls();
+}
+
+
+/*
+ * Interrupt waiting for tracking data.
+ */
+void DTrackSDK::interruptReceive()
+{
+	if ( d_udp == NULL )  return;
+
+	d_udp->interrupt();
+}
+
+
+/*
+ * Allow receiving tracking data again, after interruptReceive().
+ */
+void DTrackSDK::resumeReceive()
+{
+	if ( d_udp == NULL )  return;
+
+	d_udp->resetInterrupt();
+
+	// data received meanwhile is outdated
+	d_udp->discardPending();
+	d_backlog_first = d_backlog_num = 0;
+}
+
+
+/*
+ * Get arrival time of the latest tracking data packet.
+ */
+double DTrackSDK::getReceiveTimestamp() const
+{
+	return d_receive_timestamp;
+}
+
+
+/*
+ * Get time passed since the latest tracking data packet arrived.
+ */
+double DTrackSDK::getReceiveAge() const
+{
+	if ( d_receive_timestamp <= 0.0 )  return 0.0;
+
+	double age = DTrackNet::UDP::getSystemTime() - d_receive_timestamp;
+	return ( age > 0.0 ) ? age : 0.0;  // system time might have been adjusted
+}
+
+
+/*
+ * Returns if arrival times of tracking data packets are taken by the kernel.
+ */
+bool DTrackSDK::isKernelTimestamp() const
+{
+	if ( d_udp == NULL )  return false;
+
+	return d_udp->isKernelTimestamp();
+}
+
+
+/*
+ * Set size of receive buffer for tracking data.
+ */
+int DTrackSDK::setReceiveBufferSize( int bytes )
+{
+	if ( d_udp == NULL )  return -1;
+
+	return d_udp->setReceiveBufferSize( bytes );
+}
+
+
+/*
+ * Set busy polling of the network device while waiting for tracking data.
+ */
+bool DTrackSDK::setBusyPoll( int us )
+{
+	if ( d_udp == NULL )  return false;
+
+	return d_udp->setBusyPoll( us );
+}
+
+
+/*
+ * Set time to spin before blocking, while waiting for tracking data.
+ */
+void DTrackSDK::setSpinWait( int us )
+{
+	if ( d_udp == NULL )  return;
+
+	d_udp->setSpinTime( us );
+}
+
+
+/*
+ * Get statistics of waiting for tracking data.
+ */
+DTrackNet::WaitStatistics DTrackSDK::getWaitStatistics() const
+{
+	DTrackNet::WaitStatistics stats;
+
+	if ( d_udp == NULL )
+	{
+		memset( &stats, 0, sizeof( stats ) );
+		return stats;
+	}
+
+	return d_udp->getWaitStatistics();
+}
+
+
+/*
+ * Reset statistics of waiting for tracking data.
+ */
+void DTrackSDK::resetWaitStatistics()
+{
+	if ( d_udp == NULL )  return;
+
+	d_udp->resetWaitStatistics();
+}
+
+
+/*
+ * Reset all statistics of receiving tracking data.
+ */
+void DTrackSDK::resetStatistics()
+{
+	d_backlog_dropped = 0;
+	d_udp_maxpacket = 0;
+	d_udp_truncated = 0;
+	resetLineCounters();
+
+	if ( d_udp == NULL )  return;
+
+	d_udp->resetStatistics();
+}
+
+
+/*
+ * (Re-)creates the buffers for queued packets.
+ */
+void DTrackSDK::resizeBacklog()
+{
+	size_t i;
+
+	d_backlog_dropped += d_backlog_num;  // queued packets get lost
+	d_backlog_first = d_backlog_num = 0;
+
+	for ( i = 0; i < d_backlog_buf.size(); i++ )
+		free( d_backlog_buf[ i ] );
+
+	d_backlog_buf.clear();
+	d_backlog_len.clear();
+	d_backlog_time.clear();
+
+	if ( d_backlog_policy != BACKLOG_BOUNDED )
+		return;
+
+	d_backlog_buf.resize( d_backlog_max + 1, NULL );  // one for the packet being received
+	d_backlog_len.resize( d_backlog_max + 1, 0 );
+	d_backlog_time.resize( d_backlog_max + 1, 0.0 );
+	for ( i = 0; i < d_backlog_buf.size(); i++ )
+		d_backlog_buf[ i ] = (char *)malloc( d_udpbufsize );
+}
+
+
+/*
+ * Set limit for automatic growing of the UDP buffer.
+ */
+void DTrackSDK::setDataBufferSizeLimit( int maxSize )
+{
+	d_udpbufsize_max = ( maxSize > 0 ) ? maxSize : DEFAULT_UDP_BUFSIZE_MAX;
+}
+
+
+/*
+ * Get current UDP buffer size for receiving tracking data.
+ */
+int DTrackSDK::getDataBufferSize() const
+{
+	return d_udpbufsize;
+}
+
+
+/*
+ * Get size of the biggest tracking data packet received so far.
+ */
+int DTrackSDK::getMaxPacketSize() const
+{
+	return d_udp_maxpacket;
+}
+
+
+/*
+ * Get number of tracking data packets, that did not fit into the UDP buffer.
+ */
+unsigned int DTrackSDK::getNumTruncatedPackets() const
+{
+	return d_udp_truncated;
+}
+
+
+/*
+ * Enlarge UDP buffer after a packet did not fit.
+ *
+ * Grows geometrically, so big setups need just a few steps, but at least to the size of the packet.
+ */
+bool DTrackSDK::growDataBuffer( int packetSize )
+{
+	int newSize = d_udpbufsize * 2;
+	while ( newSize <= packetSize )  // one more for terminating '\0'
+		newSize *= 2;
+
+	if ( newSize > d_udpbufsize_max )
+		newSize = d_udpbufsize_max;
+
+	if ( newSize <= d_udpbufsize )
+		return false;
+
+	return setDataBufferSize( newSize );
+}
+
+
+/*
+ * Receive one UDP packet, keeping a bounded number of queued packets.
+ *
+ * Fetches all queued packets from the socket into the backlog, dropping the oldest ones if
+ * it is full, and returns the oldest packet of the backlog in the UDP buffer.
+ */
+int DTrackSDK::receiveBounded( int toutUs )
+{
+	int num = (int )d_backlog_buf.size();
+	int len, next;
+	if ( d_backlog_num > 0 )  // wait only if backlog is empty
+		toutUs = 0;
+
+	while ( true )
+	{
+		next = ( d_backlog_first + d_backlog_num ) % num;
+		if ( d_backlog_buf[ next ] == NULL )
+			return -2;
+
+		len = d_udp->receiveNext( d_backlog_buf[ next ], d_udpbufsize - 1, toutUs );
+		if ( len == -1 )  // no more data
+			break;
+
+		if ( len < 0 )
+			return len;
+
+		d_backlog_len[ next ] = len;
+		d_backlog_time[ next ] = d_udp->getReceiveTimestamp();
+		d_backlog_num++;
+		if ( d_backlog_num > d_backlog_max )
+		{  // drop oldest packet
+			d_backlog_first = ( d_backlog_first + 1 ) % num;
+			d_backlog_num--;
+			d_backlog_dropped++;
+		}
+
+		toutUs = 0;
+	}
+
+	if ( d_backlog_num == 0 )  // timeout
+		return -1;
+
+	// swap buffers, no copy needed:
+	char* buf = d_udpbuf;
+	d_udpbuf = d_backlog_buf[ d_backlog_first ];
+	d_backlog_buf[ d_backlog_first ] = buf;
+
+	len = d_backlog_len[ d_backlog_first ];
+	d_receive_timestamp = d_backlog_time[ d_backlog_first ];
+	d_backlog_first = ( d_backlog_first + 1 ) % num;
+	d_backlog_num--;
+	return len;
+}
+
+
 /*
  * Receive and process one tracking data packet.
  */
 bool DTrackSDK::receive()
 {
-	char* s;
+	return receiveData( d_udptimeout_us );
+}
+
+
+/*
+ * Receive and process one tracking data packet, if available, without waiting.
+ */
+bool DTrackSDK::receiveAvailable()
+{
+	return receiveData( 0 );
+}
+
+
+/*
+ * Returns if tracking data packets are already fetched, but not yet processed.
+ */
+bool DTrackSDK::hasPendingData() const
+{
+	if ( d_udp == NULL )  return false;
+
+	if ( d_backlog_policy == BACKLOG_BOUNDED && d_backlog_num > 0 )
+		return true;
+
+	return d_udp->hasPendingData();
+}
+
+
+/*
+ * Receive and process one tracking data packet, waiting no longer than the given timeout.
+ */
+bool DTrackSDK::receiveData( int toutUs )
+{
+	const char* s;
+	const char* end;
 	int len;
 	
 	lastDataError = ERR_NONE;
@@ -361,29 +749,54 @@ bool DTrackSDK::receive()
 	startFrame();
 	
 	// receive UDP packet:
-	len = d_udp->receive( d_udpbuf, d_udpbufsize - 1, d_udptimeout_us );
+	switch ( d_backlog_policy )
+	{
+		case BACKLOG_PROCESS_ALL:
+			len = d_udp->receiveNext( d_udpbuf, d_udpbufsize - 1, toutUs );
+			d_receive_timestamp = d_udp->getReceiveTimestamp();
+			break;
+		case BACKLOG_BOUNDED:
+			len = receiveBounded( toutUs );  // sets arrival time itself
+			break;
+		default:
+			len = d_udp->receive( d_udpbuf, d_udpbufsize - 1, toutUs, &d_backlog_dropped );
+			d_receive_timestamp = d_udp->getReceiveTimestamp();
+			break;
+	}
 	if (len == -1) {
 		lastDataError = ERR_TIMEOUT;
 		return false;
 	}
+
+	if (len == -5) {
+		lastDataError = ERR_INTERRUPTED;
+		return false;
+	}
+
+	if (len == -4) {  // packet lost, as it did not fit: enlarge buffer for the following ones
+		d_udp_truncated++;
+		growDataBuffer( d_udp->getTruncatedSize() );
+		lastDataError = ERR_NET;
+		return false;
+	}
 	
 	if (len <= 0) {
 		lastDataError = ERR_NET;
 		return false;
 	}
 	
+	d_udpbuf[len] = '\0';  // for getBuf()
+	d_udplen = static_cast< size_t >( len );
+	if ( len > d_udp_maxpacket )
+		d_udp_maxpacket = len;
 	s = d_udpbuf;
-	s[len] = '\0';
+	end = d_udpbuf + len;
 	
 	// process lines:
 	lastDataError = ERR_PARSE;
 	
-	do {
-		if (!parseLine(&s))
-			return false;
-
-		s = string_nextline( d_udpbuf, s, d_udpbufsize );
-	} while ( s != NULL );
+	if (!parsePacket(s, end))
+		return false;
 
 	endFrame();
 	
@@ -397,8 +810,17 @@ bool DTrackSDK::receive()
  */
 bool DTrackSDK::processPacket( const std::string& data )
 {
-	char* sBuf;
-	char* s;
+	return processPacket( data.c_str(), strlen( data.c_str() ) );  // up to first '\0', as before
+}
+
+
+/*
+ * Process one tracking packet manually, without copying it.
+ */
+bool DTrackSDK::processPacket( const char* data, size_t len )
+{
+	const char* s;
+	const char* end;
 	
 	lastDataError = ERR_NONE;
 	lastServerError = ERR_NONE;
@@ -406,28 +828,21 @@ bool DTrackSDK::processPacket( const std::string& data )
 	// defaults:
 	startFrame();
 	
-	if ( data.length() == 0 )
+	if ( data == NULL || len == 0 )
 	{
 		lastDataError = ERR_PARSE;
 		return false;
 	}
 
-	sBuf = (char *)malloc( data.length() + 1 );
-	if ( sBuf == NULL )  return false;
-
-	strcpy_s( sBuf, data.length() + 1, data.c_str() );
-
-	s = sBuf;
+	// parsing does not modify the data, so no copy is needed
+	s = data;
+	end = data + len;
 	
 	// process lines:
 	lastDataError = ERR_PARSE;
 	
-	do {
-		if (!parseLine(&s))
-			return false;
-
-		s = string_nextline( sBuf, s, static_cast< int >( data.length() ) );
-	} while( s != NULL );
+	if (!parsePacket(s, end))
+		return false;
 
 	endFrame();
 	
@@ -444,7 +859,17 @@ std::string DTrackSDK::getBuf() const
 	if ( d_udpbuf == NULL )
 		return std::string( "" );
 
-	return std::string( d_udpbuf );
+	return std::string( d_udpbuf, d_udplen );
+}
+
+
+/*
+ * Get content of the UDP buffer, without copying it.
+ */
+const char* DTrackSDK::getBufView( size_t& len ) const
+{
+	len = ( d_udpbuf != NULL ) ? d_udplen : 0;
+	return d_udpbuf;
 }
 
 
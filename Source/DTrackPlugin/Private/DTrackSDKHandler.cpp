@@ -29,28 +29,77 @@
 
 #include "DTrackLiveLinkSource.h"
 #include "HAL/RunnableThread.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/ScopeLock.h"
+#include "DTrackReactor.hpp"
 #include "Math/UnrealMathUtility.h"
 
 
+static_assert(DTRACK_FLYSTICK_MAX_JOYSTICK == DTRACKSDK_FLYSTICK_MAX_JOYSTICK, "Flystick joystick capacity differs from the DTrack SDK");
+static_assert(DTRACKSDK_FLYSTICK_MAX_BUTTON < 32, "Flystick buttons do not fit into the button mask");
+
+
 /**
  * FDTrackSDKHandler static const variable initialization
  */
 
-const FMatrix FDTrackSDKHandler::m_trafo_normal = FMatrix(
-	  FPlane( 1.0f,  0.0f, 0.0f, 0.0f )
-	, FPlane( 0.0f, -1.0f, 0.0f, 0.0f )
-	, FPlane( 0.0f,  0.0f, 1.0f, 0.0f )
-	, FPlane( 0.0f,  0.0f, 0.0f, 1.0f ));
+const FQuat FDTrackSDKHandler::m_left_hand_adjustment = FRotator(0.f, 0.f, -90.f).Quaternion();
 
-const FMatrix FDTrackSDKHandler::m_trafo_normal_transposed(m_trafo_normal.GetTransposed());
+const FQuat FDTrackSDKHandler::m_right_hand_adjustment = FRotator(180.f, 0.f, 90.f).Quaternion();
 
-const FMatrix FDTrackSDKHandler::m_trafo_powerwall = FMatrix(
-	  FPlane( 1.0f, 0.0f,  0.0f, 0.0f )
-	, FPlane( 0.0f, 0.0f,  1.0f, 0.0f )
-	, FPlane( 0.0f, 1.0f,  0.0f, 0.0f )
-	, FPlane( 0.0f, 0.0f,  0.0f, 1.0f ));
+const FQuat FDTrackSDKHandler::m_left_finger_adjustment = FRotator(0.f, 0.f, -90.f).Quaternion();
 
-const FMatrix FDTrackSDKHandler::m_trafo_powerwall_transposed(m_trafo_powerwall.GetTransposed());
+// 180 for "x" in HandSpace is "z" -> RightHandSpace-Z is flipped by 180 compared to LeftHandSpace-Z
+const FQuat FDTrackSDKHandler::m_right_finger_adjustment = FRotator(180.f, 0.f, -90.f).Quaternion();
+
+// More expressive in Blueprints than just indices
+const EDTrackFingerType FDTrackSDKHandler::m_finger_types[DTRACKSDK_HAND_MAX_FINGER] = {
+	EDTrackFingerType::FT_Thumb,
+	EDTrackFingerType::FT_Index,
+	EDTrackFingerType::FT_Middle,
+	EDTrackFingerType::FT_Ring,
+	EDTrackFingerType::FT_Pinky,
+};
+
+
+/**
+ * Axis mapping of the DTrack room calibrations into Unreal space, selected at compile time
+ */
+
+namespace {
+
+template<EDTrackCoordinateSystemType CoordinateSystem>
+struct TDTrackRoomAxes;
+
+// Z-axis pointing upwards; Y is negated as Unreal is left-handed
+template<>
+struct TDTrackRoomAxes<EDTrackCoordinateSystemType::CST_Normal> {
+
+	// location in mm to Unreal location in cm
+	static FORCEINLINE FVector location(double n_x, double n_y, double n_z) {
+		return FVector(n_x / 10.0, -n_y / 10.0, n_z / 10.0);
+	}
+
+	// quaternion (w, x, y, z) to Unreal rotation
+	static FORCEINLINE FQuat rotation(double n_w, double n_x, double n_y, double n_z) {
+		return FQuat(-n_x, n_y, -n_z, n_w);
+	}
+};
+
+// Y-axis pointing upwards; Y and Z are swapped
+template<>
+struct TDTrackRoomAxes<EDTrackCoordinateSystemType::CST_Powerwall> {
+
+	static FORCEINLINE FVector location(double n_x, double n_y, double n_z) {
+		return FVector(n_x / 10.0, n_z / 10.0, n_y / 10.0);
+	}
+
+	static FORCEINLINE FQuat rotation(double n_w, double n_x, double n_y, double n_z) {
+		return FQuat(-n_x, -n_z, -n_y, n_w);
+	}
+};
+
+}  // namespace
 
 
 /**
@@ -58,7 +107,8 @@ const FMatrix FDTrackSDKHandler::m_trafo_powerwall_transposed(m_trafo_powerwall.
  */
 
 FDTrackSDKHandler::FDTrackSDKHandler(FDTrackLiveLinkSource* n_livelink_source)
-	: m_livelink_source(n_livelink_source)
+	: m_handle_frame(&FDTrackSDKHandler::handle_frame<EDTrackCoordinateSystemType::CST_Normal, false>)
+	, m_livelink_source(n_livelink_source)
 	, m_frame_worldtime(-1.0)
 	, m_frame_timestamp_seconds(-1.0)
 {
@@ -75,6 +125,17 @@ bool FDTrackSDKHandler::start_listening(const FDTrackServerSettings& n_server_se
 
 	m_server_settings = n_server_settings;
 
+	// the coordinate system and room transform are fixed while listening, so the frame handling is chosen once
+	switch (m_server_settings.m_coordinate_system) {
+	default:
+	case EDTrackCoordinateSystemType::CST_Normal:
+		select_frame_handling<EDTrackCoordinateSystemType::CST_Normal>(m_server_settings);
+		break;
+	case EDTrackCoordinateSystemType::CST_Powerwall:
+		select_frame_handling<EDTrackCoordinateSystemType::CST_Powerwall>(m_server_settings);
+		break;
+	}
+
 #if 0
 	switch (m_server_settings.m_coordinate_system) {
 	case EDTrackCoordinateSystemType::CST_Normal:
@@ -87,6 +148,7 @@ bool FDTrackSDKHandler::start_listening(const FDTrackServerSettings& n_server_se
 	}
 #endif
 
+	m_stop_requested = false;
 	m_thread.Reset(FRunnableThread::Create(this, TEXT("DTrackSDKHandler")));
 	return true;
 }
@@ -94,10 +156,9 @@ bool FDTrackSDKHandler::start_listening(const FDTrackServerSettings& n_server_se
 void FDTrackSDKHandler::stop_listening() {
 
 	if (m_thread) {
-		if (m_is_active) {
-			Stop();
-			m_thread->Kill(true);
-		}
+		// Stop() wakes up a waiting receive, so the thread ends without waiting for the UDP timeout
+		Stop();
+		m_thread->WaitForCompletion();
 
 		m_thread.Reset();
 	}
@@ -131,216 +192,222 @@ FString FDTrackSDKHandler::get_status() const {
 	}
 }
 
-void FDTrackSDKHandler::update_frametime() {
+const DTrackFrame* FDTrackSDKHandler::acquire_latest_frame() {
 
-	m_frame_worldtime = FPlatformTime::Seconds();
-	m_frame_timestamp_seconds = m_dtrack->getTimeStamp();
+	return m_frame_buffer.acquireLatest();
 }
 
-void FDTrackSDKHandler::handle_bodies() {
+void FDTrackSDKHandler::release_frame(const DTrackFrame* n_frame) {
 
-	const DTrack_Body_Type_d *body = nullptr;
-	for (int i = 0; i < m_dtrack->getNumBody(); i++) { 
+	m_frame_buffer.release(n_frame);
+}
+
+uint32 FDTrackSDKHandler::get_num_dropped_frames() const {
+
+	return static_cast<uint32>(m_num_dropped_frames.GetValue());
+}
+
+void FDTrackSDKHandler::update_frametime(DTrackSDK& n_dtrack) {
+
+	// arrival time of the packet, converted to engine clock; excludes waiting in the backlog and parsing
+	m_frame_worldtime = FPlatformTime::Seconds() - n_dtrack.getReceiveAge();
+	m_frame_timestamp_seconds = n_dtrack.getTimeStamp();
+}
 
-		body = m_dtrack->getBody(i);
-		checkf(body, TEXT("DTrack API error, body address null"));
+template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+void FDTrackSDKHandler::handle_bodies(DTrackSDK& n_dtrack, int32 n_source) {
 
-		const FVector translation = from_dtrack_location(body->loc);
-		const FRotator rotation = from_dtrack_rotation(body->rot);
-		m_livelink_source->handle_body_data_anythread(m_frame_worldtime, m_frame_timestamp_seconds, body->id, body->quality, translation, rotation);
+	// just bodies, that are tracked or were tracked in the frame before
+	const DTrackPoseArrays& poses = n_dtrack.getBodyPoseArrays();
+
+	// all locations and rotations in one pass
+	from_dtrack_locations<CoordinateSystem, RoomTransform>(poses, m_pose_locations);
+	from_dtrack_rotations<CoordinateSystem, RoomTransform>(poses, m_pose_rotations);
+
+	for (int i = 0; i < poses.num; i++) {
+		m_livelink_source->handle_body_data_anythread(m_frame_worldtime, m_frame_timestamp_seconds, n_source, poses.id[i], poses.quality[i], m_pose_locations[i], m_pose_rotations[i]);
 	}
 }
 
-void FDTrackSDKHandler::handle_flysticks() 
+template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+void FDTrackSDKHandler::handle_flysticks(DTrackSDK& n_dtrack, int32 n_source)
 {
 #if 0
 	// DBG
-	UE_LOG( LogDTrackPlugin, Warning, TEXT("#flysticks %d"), m_dtrack->getNumFlyStick() );
-	for ( int i = 0;  i < m_dtrack->getNumFlyStick();  ++i) {
-		const DTrack_FlyStick_Type_d *fs = m_dtrack->getFlyStick(i);
+	UE_LOG( LogDTrackPlugin, Warning, TEXT("#flysticks %d"), n_dtrack.getNumFlyStick() );
+	for ( int i = 0;  i < n_dtrack.getNumFlyStick();  ++i) {
+		const DTrack_FlyStick_Type_d *fs = n_dtrack.getFlyStick(i);
 		UE_LOG( LogDTrackPlugin, Warning, TEXT("flystick %d #buttons %d #joysticks %d"), i, fs->num_button, fs->num_joystick);
 	}
 #endif
 
+	// all calibrated flysticks, in order of their ids
+	const DTrackPoseArrays& poses = n_dtrack.getFlyStickPoseArrays();
+	from_dtrack_locations<CoordinateSystem, RoomTransform>(poses, m_pose_locations);
+	from_dtrack_rotations<CoordinateSystem, RoomTransform>(poses, m_pose_rotations);
+
 	const DTrack_FlyStick_Type_d *flystick = nullptr;
-	for (int i = 0; i < m_dtrack->getNumFlyStick(); i++) {
-		flystick = m_dtrack->getFlyStick(i);
+	for (int i = 0; i < poses.num; i++) {
+		flystick = n_dtrack.getFlyStick(i);
 		checkf(flystick, TEXT("DTrack API error, flystick address null"));
 
-		const FVector translation = from_dtrack_location(flystick->loc);
-		const FRotator rotation = from_dtrack_rotation(flystick->rot);
+		const FVector& translation = m_pose_locations[i];
+		const FQuat& rotation = m_pose_rotations[i];
 
-		// create a state vector for the button states
-		TArray<bool> buttons;
-		buttons.SetNumZeroed(flystick->num_button);
+		// button states as bits, to avoid allocations per frame
+		int32 button_mask = 0;
 		for (int idx = 0; idx < flystick->num_button; idx++) {
-			buttons[idx] = flystick->button[idx] == 1;
+			button_mask |= (flystick->button[idx] == 1) << idx;
 		}
 
-		// create a state vector for the joystick states
-		TArray<float> joysticks;  // have to use float as blueprints don't support TArray<double>
-		joysticks.SetNumZeroed(flystick->num_joystick);
+		// joystick states on the stack
+		float joysticks[DTRACK_FLYSTICK_MAX_JOYSTICK];  // have to use float as blueprints don't support double
 		for (int idx = 0; idx < flystick->num_joystick; idx++) {
 			joysticks[idx] = static_cast<float>(flystick->joystick[idx]);
 		}
 
 		m_livelink_source->handle_flystick_data_anythread( m_frame_worldtime, m_frame_timestamp_seconds, 
-			flystick->id, flystick->quality, translation, rotation, buttons, joysticks);
+			n_source, flystick->id, flystick->quality, translation, rotation,
+			flystick->num_button, button_mask, flystick->num_joystick, joysticks);
 	}
 }
 
 
-void FDTrackSDKHandler::handle_hands()
+template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+void FDTrackSDKHandler::handle_hands(DTrackSDK& n_dtrack, int32 n_source)
 {
 	const DTrackHand *hand = nullptr;
 
 #if 0
-	UE_LOG (LogDTrackPlugin, Warning, TEXT("DTrackSDKHandler: NumHand:   %d"),  m_dtrack->getNumHand() );
+	UE_LOG (LogDTrackPlugin, Warning, TEXT("DTrackSDKHandler: NumHand:   %d"),  n_dtrack.getNumHand() );
 #endif
 
-	for ( int i = 0; i < m_dtrack->getNumHand(); ++i )
-	{
-		hand = m_dtrack->getHand(i);
-		checkf(hand, TEXT("DTrack API error, hand address is null"));
+	// storage never shrinks, so there are no allocations in steady state
+	m_hand_poses.Reset();
+	m_fingers.Reset();
 
-		FVector location  = from_dtrack_location( hand->loc );
-		FRotator rotation = from_dtrack_rotation( hand->rot );
-		FVector scale     = FVector( 1.0f, 1.0f, 1.0f );
-
-		TArray<FDTrackFinger> fingers;
-		fingers.Reserve( hand->nfinger );
-
-		TArray<EDTrackFingerType> fingers_type;
-		fingers_type.SetNumUninitialized( hand->nfinger );
+	// just hands, that are tracked or were tracked in the frame before
+	for ( int i = 0; i < n_dtrack.getNumChangedHand(); ++i )
+	{
+		hand = n_dtrack.getChangedHand(i);
+		if ( !hand )
+		{
+			continue;  // not calibrated anymore
+		}
 
-		FTransform handTransform;
-		handTransform.SetComponents( rotation.Quaternion(), location, scale );
+		FHandPose& hand_pose = m_hand_poses[m_hand_poses.AddUninitialized()];
+		hand_pose.m_hand = hand;
+		hand_pose.m_first_finger = m_fingers.Num();
+		hand_pose.m_transform.SetComponents(
+			from_dtrack_rotation<CoordinateSystem, RoomTransform>( hand->rot ),
+			from_dtrack_location<CoordinateSystem, RoomTransform>( hand->loc ),
+			FVector( 1.0f, 1.0f, 1.0f ) );
 
+		m_fingers.AddDefaulted( hand->nfinger );
 		for (int j = 0; j < hand->nfinger; ++j)
 		{
-			FDTrackFinger finger;
-
-			switch (j) 
-			{
-			// More expressive in Blueprints than just indices
-			case 0: fingers_type[j] = EDTrackFingerType::FT_Thumb;  break;
-			case 1: fingers_type[j] = EDTrackFingerType::FT_Index;  break;
-			case 2: fingers_type[j] = EDTrackFingerType::FT_Middle; break;
-			case 3: fingers_type[j] = EDTrackFingerType::FT_Ring;   break;
-			case 4: fingers_type[j] = EDTrackFingerType::FT_Pinky;  break;
-			}
+			FDTrackFinger& finger = m_fingers[hand_pose.m_first_finger + j];
 
 			// In hand space coordinate (see DTrack2 Manual Technical Appendix)
 			finger.m_tip_transform.SetComponents(
-				from_dtrack_rotation( hand->finger[j].rot ).Quaternion(),
-				from_dtrack_location( hand->finger[j].loc ),
-				scale );
+				from_dtrack_hand_rotation<CoordinateSystem, RoomTransform>( hand->finger[j].rot ),
+				from_dtrack_hand_location<CoordinateSystem, RoomTransform>( hand->finger[j].loc ),
+				FVector( 1.0f, 1.0f, 1.0f ) );
 			finger.m_tip_radius                 = hand->finger[j].radiustip;
 			finger.m_inner_phalanx_length       = hand->finger[j].lengthphalanx[2];
 			finger.m_middle_phalanx_length      = hand->finger[j].lengthphalanx[1];
 			finger.m_outer_phalanx_length       = hand->finger[j].lengthphalanx[0];
 			finger.m_inner_middle_phalanx_angle = hand->finger[j].anglephalanx[1];
 			finger.m_middle_outer_phalanx_angle = hand->finger[j].anglephalanx[0];
+		}
+	}
+
+	if ( m_hand_poses.Num() == 0 )
+	{
+		return;
+	}
 
+	// phalanx lengths are given along the X and Z axes of the DTrack finger coordinate system (in mm)
+	static const double dtrack_finger_axis_x[3] = { 1.0, 0.0, 0.0 };
+	static const double dtrack_finger_axis_z[3] = { 0.0, 0.0, 1.0 };
 
-			// Left-Hand is 0, Right-Hand is 1
-			if ( hand->lr == 0 )
-			{
-				compute_finger_joint_pose( handTransform, finger,  0.f,  0.f,  -90.f );
-				//compute_finger_joint_pose( handTransform, finger,  0.f,  0.f,  0.f );
-			}
-			else
-			{   // 180 for "x" in HandSpace is "z" -> RightHandSpace-Z is flipped by 180 compared to LeftHandSpace-Z
-				compute_finger_joint_pose( handTransform, finger,  180.f,  0.f, -90.f );
-			}
-			fingers.Add( MoveTemp(finger) );
-		}
-		
+	// all fingers of all hands in one pass
+	compute_finger_poses(
+		from_dtrack_hand_location<CoordinateSystem, RoomTransform>( dtrack_finger_axis_x ),
+		from_dtrack_hand_location<CoordinateSystem, RoomTransform>( dtrack_finger_axis_z ) );
+
+	for ( FHandPose& hand_pose : m_hand_poses )
+	{
+		hand = hand_pose.m_hand;
+
+		// adding to roll is a rotation about the local X-Axis, i.e. appended to the hand rotation
 		if ( hand->lr == 0 )
 		{
-			rotation.Add( 0.f, 0.f, -90.f );
+			hand_pose.m_transform.SetRotation( hand_pose.m_transform.GetRotation() * m_left_hand_adjustment );
 		}
 		else
 		{
-			// mirror X-Axis because Unreal-Right-Hand-Skeletons X direction is negative compared to the left hand
-			rotation.SetComponentForAxis( EAxis::X,  -1.0f * rotation.GetComponentForAxis(EAxis::X) );
-			rotation.Add( 180.f, 0.f, 90.f );
+			// mirror X-Axis because Unreal-Right-Hand-Skeletons X direction is negative compared to the left hand;
+			// negating roll and adding (180, 0, 90) to the rotator is the same as appending FRotator(180, 0, 90)
+			hand_pose.m_transform.SetRotation( hand_pose.m_transform.GetRotation() * m_right_hand_adjustment );
 		}
 
-		handTransform.SetRotation( rotation.Quaternion() );
-
+		// Left-Hand is 0, Right-Hand is 1
 		m_livelink_source->handle_hand_data_anythread(
-			m_frame_worldtime, m_frame_timestamp_seconds, hand->id, hand->quality, 
-			(hand->lr == 1), handTransform, fingers_type, fingers);
+			m_frame_worldtime, m_frame_timestamp_seconds, n_source, hand->id, hand->quality, 
+			(hand->lr == 1), hand_pose.m_transform,
+			TArrayView<const EDTrackFingerType>( m_finger_types, hand->nfinger ),
+			TArrayView<const FDTrackFinger>( m_fingers.GetData() + hand_pose.m_first_finger, hand->nfinger ) );
 	}
 }
 
 
 
-void FDTrackSDKHandler::compute_finger_joint_pose(
-	const FTransform& n_hand_transform, FDTrackFinger& out_finger, const float finger_x_rotation, 
-	const float finger_y_rotation, const float finger_z_rotation)
+void FDTrackSDKHandler::compute_finger_poses(const FVector& n_finger_axis_x, const FVector& n_finger_axis_z)
 {
-	double dtrack_finger_space_loc[3];
-
-	// calculating the position for tip and all joints of the fingers in world space
-
-	// first joint (in finger coordinate system)
-	dtrack_finger_space_loc[0] = -out_finger.m_outer_phalanx_length;
-	dtrack_finger_space_loc[1] = dtrack_finger_space_loc[2] = 0.0;
-	const FVector finger_space_location_outerphalanx = from_dtrack_location(dtrack_finger_space_loc);
-
-	//Convert outer phalanx to hand space
-	const FVector hand_space_outerphalanx_location = out_finger.m_tip_transform.TransformPosition(finger_space_location_outerphalanx);
-	const FQuat hand_space_outerphalanx_rotation = out_finger.m_tip_transform.GetRotation() * FRotator(finger_x_rotation, finger_y_rotation, finger_z_rotation).Quaternion();
-
-	//Convert outer phalanx to world space
-	FTransform world_outer_phalanx_transform;
-	world_outer_phalanx_transform.SetLocation(n_hand_transform.TransformPosition(hand_space_outerphalanx_location));
-	world_outer_phalanx_transform.SetRotation(n_hand_transform.TransformRotation(hand_space_outerphalanx_rotation));
-	out_finger.m_outer_phalanx_transform = MoveTemp(world_outer_phalanx_transform);
-
-
-	// second joint (in finger coordinate system)
-	dtrack_finger_space_loc[0] = -out_finger.m_outer_phalanx_length - out_finger.m_middle_phalanx_length * cos(out_finger.m_middle_outer_phalanx_angle * PI / 180.0);
-	dtrack_finger_space_loc[1] = 0.0;
-	dtrack_finger_space_loc[2] = out_finger.m_middle_phalanx_length * sin(out_finger.m_middle_outer_phalanx_angle * PI / 180.0);
-	const FVector finger_space_location_middlephalanx = from_dtrack_location(dtrack_finger_space_loc);
-	const FQuat finger_space_rotation_middlephalanx = FQuat(FVector(0.0f, 1.0f, 0.0f), out_finger.m_middle_outer_phalanx_angle * PI / 180.f).Rotator().Add(finger_x_rotation, finger_y_rotation, finger_z_rotation).Quaternion();
-
-	//Convert middle phalanx to hand space
-	const FVector hand_space_middlephalanx_location = out_finger.m_tip_transform.TransformPosition(finger_space_location_middlephalanx);
-	const FQuat hand_space_middlephalanx_rotation = out_finger.m_tip_transform.TransformRotation(finger_space_rotation_middlephalanx);
-
-	//Convert middle phalanx to world space
-	FTransform world_middle_phalanx_transform;
-	world_middle_phalanx_transform.SetLocation(n_hand_transform.TransformPosition(hand_space_middlephalanx_location));
-	world_middle_phalanx_transform.SetRotation(n_hand_transform.TransformRotation(hand_space_middlephalanx_rotation));
-	out_finger.m_middle_phalanx_transform = MoveTemp(world_middle_phalanx_transform);
-
-
-	// third joint (in finger coordinate system)
-	dtrack_finger_space_loc[0] = -out_finger.m_outer_phalanx_length
-		- out_finger.m_middle_phalanx_length * cos(out_finger.m_middle_outer_phalanx_angle * PI / 180.0)
-		- out_finger.m_inner_phalanx_length * cos((out_finger.m_middle_outer_phalanx_angle + out_finger.m_inner_middle_phalanx_angle) * PI / 180.0);
-	dtrack_finger_space_loc[1] = 0.0;
-	dtrack_finger_space_loc[2] = out_finger.m_middle_phalanx_length * sin(out_finger.m_middle_outer_phalanx_angle * PI / 180.0)
-		+ out_finger.m_inner_phalanx_length * sin((out_finger.m_middle_outer_phalanx_angle + out_finger.m_inner_middle_phalanx_angle) * PI / 180.0);
-	const FVector finger_space_location_innerphalanx = from_dtrack_location(dtrack_finger_space_loc);
-	const FQuat finger_space_rotation_innerphalanx = FQuat(FVector(0.0f, 1.0f, 0.0f), (out_finger.m_middle_outer_phalanx_angle + out_finger.m_inner_middle_phalanx_angle) * PI / 180.0).Rotator().Add(finger_x_rotation, finger_y_rotation, finger_z_rotation).Quaternion();
-	
-	// Convert inner phalanx to hand space
-	const FVector hand_space_innerphalanx_location = out_finger.m_tip_transform.TransformPosition(finger_space_location_innerphalanx);
-	const FQuat hand_space_innerphalanx_rotation = out_finger.m_tip_transform.TransformRotation(finger_space_rotation_innerphalanx);
-
-	// Convert inner phalanx to world space
-	FTransform world_inner_phalanx_transform;
-	world_inner_phalanx_transform.SetLocation(n_hand_transform.TransformPosition(hand_space_innerphalanx_location));
-	world_inner_phalanx_transform.SetRotation(n_hand_transform.TransformRotation(hand_space_innerphalanx_rotation));
-	out_finger.m_inner_phalanx_transform = MoveTemp(world_inner_phalanx_transform);
+	// Each phalanx is rotated about the finger Y-Axis by the sum of the joint angles towards the tip, with the
+	// skeleton adjustment appended. Sines and cosines of the angles are derived from the ones of the half angles,
+	// which are needed for the rotations anyway.
+	for ( const FHandPose& hand_pose : m_hand_poses )
+	{
+		const FQuat hand_rotation = hand_pose.m_transform.GetRotation();
+		const FVector hand_location = hand_pose.m_transform.GetLocation();
+		const FQuat& adjustment = ( hand_pose.m_hand->lr == 0 ) ? m_left_finger_adjustment : m_right_finger_adjustment;
 
-	// Finger tip is already in hand space and hand is in world space
-	out_finger.m_tip_transform = out_finger.m_tip_transform * n_hand_transform;
+		FDTrackFinger* finger = m_fingers.GetData() + hand_pose.m_first_finger;
+		for ( int j = 0; j < hand_pose.m_hand->nfinger; ++j, ++finger )
+		{
+			// Finger tip is given in hand space and hand is in world space
+			const FQuat tip_rotation = hand_rotation * finger->m_tip_transform.GetRotation();
+			const FVector tip_location = hand_location + hand_rotation.RotateVector( finger->m_tip_transform.GetLocation() );
+
+			// finger axes in world space, including scale and unit conversion
+			const FVector axis_x = tip_rotation.RotateVector( n_finger_axis_x );
+			const FVector axis_z = tip_rotation.RotateVector( n_finger_axis_z );
+
+			float sin_outer, cos_outer, sin_inner, cos_inner;
+			FMath::SinCos( &sin_outer, &cos_outer, FMath::DegreesToRadians( 0.5f * finger->m_middle_outer_phalanx_angle ) );
+			FMath::SinCos( &sin_inner, &cos_inner, FMath::DegreesToRadians( 0.5f * ( finger->m_middle_outer_phalanx_angle + finger->m_inner_middle_phalanx_angle ) ) );
+
+			// joint locations along the finger (in finger coordinate system)
+			const float outer_x  = -finger->m_outer_phalanx_length;
+			const float middle_x = outer_x - finger->m_middle_phalanx_length * ( cos_outer * cos_outer - sin_outer * sin_outer );
+			const float middle_z = finger->m_middle_phalanx_length * 2.0f * sin_outer * cos_outer;
+			const float inner_x  = middle_x - finger->m_inner_phalanx_length * ( cos_inner * cos_inner - sin_inner * sin_inner );
+			const float inner_z  = middle_z + finger->m_inner_phalanx_length * 2.0f * sin_inner * cos_inner;
+
+			finger->m_outer_phalanx_transform = FTransform(
+				tip_rotation * adjustment,
+				tip_location + axis_x * outer_x );
+			finger->m_middle_phalanx_transform = FTransform(
+				tip_rotation * ( FQuat( 0.0f, sin_outer, 0.0f, cos_outer ) * adjustment ),
+				tip_location + axis_x * middle_x + axis_z * middle_z );
+			finger->m_inner_phalanx_transform = FTransform(
+				tip_rotation * ( FQuat( 0.0f, sin_inner, 0.0f, cos_inner ) * adjustment ),
+				tip_location + axis_x * inner_x + axis_z * inner_z );
+			finger->m_tip_transform = FTransform( tip_rotation, tip_location );
+		}
+	}
 }
 
 
@@ -367,17 +434,80 @@ uint32 FDTrackSDKHandler::Run()
 
 	m_is_connecting = true;
 
-	if (CopiedSettings.m_dtrack_start_mea || CopiedSettings.m_dtrack_tactile_fingers) {
-		UE_LOG(LogDTrackPlugin, Verbose, TEXT("Connecting to DTrack2 server with IP '%s' on port '%d'."), *CopiedSettings.m_dtrack_server_ip, m_server_settings.m_dtrack_server_port);
-		m_dtrack = MakeUnique<DTrackSDK>(TCHAR_TO_UTF8(*CopiedSettings.m_dtrack_server_ip), CopiedSettings.m_dtrack_server_port);
+	TUniquePtr<DTrackSDK> dtrack;
+	TArray<TUniquePtr<DTrackSDK>> dtrack_additional;
+	if (can_keep_sdk(CopiedSettings)) {
+		// no network settings changed: keep sockets and connection of the previous run
+		UE_LOG(LogDTrackPlugin, Verbose, TEXT("Keeping connection to DTrack server on port '%d'."), CopiedSettings.m_dtrack_server_port);
+		FScopeLock lock(&m_dtrack_lock);
+		dtrack = MoveTemp(m_dtrack);
+		dtrack_additional = MoveTemp(m_dtrack_additional);
 	}
 	else {
-		UE_LOG(LogDTrackPlugin, Verbose, TEXT("Connecting to DTrack server on port '%d'."), CopiedSettings.m_dtrack_server_port);
-		m_dtrack = MakeUnique<DTrackSDK>(CopiedSettings.m_dtrack_server_port);
+		{
+			// close the sockets of the previous run, before binding the data ports again
+			FScopeLock lock(&m_dtrack_lock);
+			m_dtrack.Reset();
+			m_dtrack_additional.Reset();
+		}
+
+		if (CopiedSettings.m_dtrack_start_mea || CopiedSettings.m_dtrack_tactile_fingers) {
+			UE_LOG(LogDTrackPlugin, Verbose, TEXT("Connecting to DTrack2 server with IP '%s' on port '%d'."), *CopiedSettings.m_dtrack_server_ip, m_server_settings.m_dtrack_server_port);
+			dtrack = MakeUnique<DTrackSDK>(TCHAR_TO_UTF8(*CopiedSettings.m_dtrack_server_ip), CopiedSettings.m_dtrack_server_port);
+		}
+		else if (!CopiedSettings.m_multicast_ip.IsEmpty()) {
+			UE_LOG(LogDTrackPlugin, Verbose, TEXT("Joining multicast group '%s' on port '%d'."), *CopiedSettings.m_multicast_ip, CopiedSettings.m_dtrack_server_port);
+			dtrack = MakeUnique<DTrackSDK>(TCHAR_TO_UTF8(*CopiedSettings.m_multicast_ip), CopiedSettings.m_dtrack_server_port);
+		}
+		else {
+			UE_LOG(LogDTrackPlugin, Verbose, TEXT("Connecting to DTrack server on port '%d'."), CopiedSettings.m_dtrack_server_port);
+			dtrack = MakeUnique<DTrackSDK>(CopiedSettings.m_dtrack_server_port);
+		}
+
+		// further servers, received by this thread too
+		for (const FDTrackAdditionalSource& source : CopiedSettings.m_additional_sources) {
+			UE_LOG(LogDTrackPlugin, Verbose, TEXT("Connecting to further DTrack server on port '%d'."), source.m_dtrack_server_port);
+			dtrack_additional.Add(MakeUnique<DTrackSDK>(source.m_dtrack_server_port));
+		}
+
+		m_sdk_settings = CopiedSettings;
 	}
-	
+
+	// Stop() while initializing could not interrupt the SDK; resuming it would lose the interrupt
+	if (m_stop_requested) {
+		FScopeLock lock(&m_dtrack_lock);
+		m_dtrack = MoveTemp(dtrack);
+		m_dtrack_additional = MoveTemp(dtrack_additional);
+		m_is_connecting = false;
+		return 0;
+	}
+
+	// a kept SDK was interrupted by Stop() of the previous run
+	dtrack->resumeReceive();
+	dtrack->resetStatistics();
+	configure_sdk(*dtrack, CopiedSettings);
+
+	// each complete frame is readable by other threads
+	dtrack->setFrameBuffer(&m_frame_buffer);
+
+	for (const TUniquePtr<DTrackSDK>& sdk : dtrack_additional) {
+		sdk->resumeReceive();
+		sdk->resetStatistics();
+		configure_sdk(*sdk, CopiedSettings);
+	}
+
+	{
+		FScopeLock lock(&m_dtrack_lock);
+		m_dtrack = MoveTemp(dtrack);
+		m_dtrack_additional = MoveTemp(dtrack_additional);
+	}
+	m_num_dropped_frames.Reset();
+
 	if (m_dtrack->isLocalDataPortValid()) {
 
+		UE_LOG(LogDTrackPlugin, Verbose, TEXT("Arrival times of tracking data are taken by %s."),
+			m_dtrack->isKernelTimestamp() ? TEXT("the kernel") : TEXT("the receiving thread"));
+
 		// start the tracking via tcp route if dtrack2 mode is enabled
 		if (CopiedSettings.m_dtrack_start_mea) {
 			UE_LOG(LogDTrackPlugin, Verbose, TEXT("Starting DTrack2 measurement."));
@@ -400,18 +530,24 @@ uint32 FDTrackSDKHandler::Run()
 		UE_LOG(LogDTrackPlugin, Error, TEXT("Could not start tracking, port '%d' is not usable."), CopiedSettings.m_dtrack_server_port);
 	}
 
-	m_is_connecting = false;
+	// checked after setting m_is_active, so a Stop() in between is not overwritten
+	if (m_stop_requested) {
+		m_is_active = false;
+	}
 
+	m_is_connecting = false;
 
-	while (m_is_active)	{
-		if (m_dtrack->receive()) {
-			update_frametime();
 
-			handle_bodies();
-			handle_flysticks();
-			handle_hands();
+	if (m_dtrack_additional.Num() == 0) {
+		while (m_is_active) {
+			if (m_dtrack->receive()) {
+				process_frame(*m_dtrack, 0);
+			}
 		}
 	}
+	else {
+		receive_all_sources(CopiedSettings);
+	}
 
 	if (CopiedSettings.m_dtrack_start_mea && m_is_measuring) {
 		UE_LOG(LogDTrackPlugin, Verbose, TEXT("Stopping DTrack2 measurement."));
@@ -422,7 +558,54 @@ uint32 FDTrackSDKHandler::Run()
 		m_is_measuring = false;
 	}
 
-	m_dtrack.Reset();
+	if (m_dtrack->getNumReceivedPackets() > 0) {
+		UE_LOG(LogDTrackPlugin, Verbose, TEXT("Received %u tracking data packets with %u system calls."),
+			m_dtrack->getNumReceivedPackets(), m_dtrack->getNumReceiveSyscalls());
+	}
+
+	// CPU cost of spinning against wake-up latency, to choose the low latency settings per machine
+	const DTrackNet::WaitStatistics wait_stats = m_dtrack->getWaitStatistics();
+	if (wait_stats.numWaits > 0) {
+		UE_LOG(LogDTrackPlugin, Verbose, TEXT("Waited %u times for data, %u got data while spinning; spinning took %.1f ms CPU time."),
+			wait_stats.numWaits, wait_stats.numSpinHits, wait_stats.spinTime * 1000.0);
+	}
+	if (wait_stats.numLatencies > 0) {
+		UE_LOG(LogDTrackPlugin, Verbose, TEXT("Wake-up latency: average %.1f us, maximum %.1f us."),
+			wait_stats.sumLatency / wait_stats.numLatencies * 1e6, wait_stats.maxLatency * 1e6);
+	}
+
+	if (m_dtrack->getNumReceivedPackets() > 0) {
+		UE_LOG(LogDTrackPlugin, Verbose, TEXT("Biggest tracking data packet had %d bytes, buffer size is %d bytes."),
+			m_dtrack->getMaxPacketSize(), m_dtrack->getDataBufferSize());
+	}
+
+	if (m_dtrack->getNumTruncatedPackets() > 0) {
+		UE_LOG(LogDTrackPlugin, Warning, TEXT("Lost %u tracking frames, that did not fit into the receive buffer."), m_dtrack->getNumTruncatedPackets());
+	}
+
+	if (m_dtrack->getNumDroppedPackets() > 0) {
+		UE_LOG(LogDTrackPlugin, Verbose, TEXT("Dropped %u queued tracking frames."), m_dtrack->getNumDroppedPackets());
+	}
+
+	// statistics of received data, per line type
+	for (int i = 0; i < DTrackParser::LINE_NUM; i++) {
+		const DTrackParser::LineType type = static_cast<DTrackParser::LineType>(i);
+		if (m_dtrack->getNumParsedLines(type) > 0) {
+			UE_LOG(LogDTrackPlugin, Verbose, TEXT("Parsed %u '%s' lines (%u errors)."), m_dtrack->getNumParsedLines(type),
+				UTF8_TO_TCHAR(DTrackParser::getLineTypeName(type)), m_dtrack->getNumParseErrors(type));
+		}
+	}
+
+	if (m_dtrack->getNumSkippedBodies() > 0) {
+		UE_LOG(LogDTrackPlugin, Verbose, TEXT("Skipped %u records of bodies not in the body filter."), m_dtrack->getNumSkippedBodies());
+	}
+
+	for (int32 i = 0; i < m_dtrack_additional.Num(); i++) {
+		UE_LOG(LogDTrackPlugin, Verbose, TEXT("Received %u tracking data packets on port '%d'."),
+			m_dtrack_additional[i]->getNumReceivedPackets(), CopiedSettings.m_additional_sources[i].m_dtrack_server_port);
+	}
+
+	// the SDK instances are kept for the next run (see can_keep_sdk()), they are interrupted until then
 	
 	UE_LOG(LogDTrackPlugin, VeryVerbose, TEXT("Workerthread stopped polling sdk."));
 
@@ -430,58 +613,307 @@ uint32 FDTrackSDKHandler::Run()
 }
 
 void FDTrackSDKHandler::Stop() {
+	m_stop_requested = true;
 	m_is_active = false;
+
+	// wake up a blocking receive, so the thread ends without waiting for the UDP timeout
+	FScopeLock lock(&m_dtrack_lock);
+	if (m_dtrack) {
+		m_dtrack->interruptReceive();
+	}
+	for (const TUniquePtr<DTrackSDK>& sdk : m_dtrack_additional) {
+		sdk->interruptReceive();
+	}
 }
 
-// translate a DTrack body location (translation in mm) into Unreal Location (in cm)
-FVector FDTrackSDKHandler::from_dtrack_location(const double(&n_translation)[3]) {
+bool FDTrackSDKHandler::can_keep_sdk(const FDTrackServerSettings& n_settings) const {
+
+	if (!m_dtrack || !m_dtrack->isLocalDataPortValid()) {
+		return false;
+	}
+
+	// settings used when creating the sockets and connection
+	if (n_settings.m_dtrack_server_port != m_sdk_settings.m_dtrack_server_port
+		|| n_settings.m_dtrack_server_ip != m_sdk_settings.m_dtrack_server_ip
+		|| n_settings.m_dtrack_start_mea != m_sdk_settings.m_dtrack_start_mea
+		|| n_settings.m_dtrack_tactile_fingers != m_sdk_settings.m_dtrack_tactile_fingers
+		|| n_settings.m_multicast_ip != m_sdk_settings.m_multicast_ip
+		|| n_settings.m_additional_sources.Num() != m_sdk_settings.m_additional_sources.Num()) {
+		return false;
+	}
+
+	for (int32 i = 0; i < n_settings.m_additional_sources.Num(); i++) {
+		if (n_settings.m_additional_sources[i].m_dtrack_server_port != m_sdk_settings.m_additional_sources[i].m_dtrack_server_port) {
+			return false;
+		}
+	}
+
+	// socket options, that are not reverted by configure_sdk()
+	if (n_settings.m_low_latency_mode != m_sdk_settings.m_low_latency_mode) {
+		return false;
+	}
+	if (n_settings.m_low_latency_mode && (n_settings.m_receive_buffer_kb != m_sdk_settings.m_receive_buffer_kb
+		|| n_settings.m_busy_poll_us != m_sdk_settings.m_busy_poll_us)) {
+		return false;
+	}
+
+	return true;
+}
+
+void FDTrackSDKHandler::configure_sdk(DTrackSDK& n_dtrack, const FDTrackServerSettings& n_settings) {
+
+	// poses of bodies are converted from arrays
+	n_dtrack.setPoseArraysEnabled(true);
+
+	switch (n_settings.m_backlog_policy) {
+	case EDTrackBacklogPolicy::BP_ProcessAll:
+		n_dtrack.setBacklogPolicy(DTrackSDK::BACKLOG_PROCESS_ALL);
+		break;
+	case EDTrackBacklogPolicy::BP_Bounded:
+		n_dtrack.setBacklogPolicy(DTrackSDK::BACKLOG_BOUNDED, FMath::Max(n_settings.m_backlog_max_frames, 1));
+		break;
+	default:
+		n_dtrack.setBacklogPolicy(DTrackSDK::BACKLOG_NEWEST_ONLY);
+		break;
+	}
+
+	if (n_settings.m_low_latency_mode) {
+		if (n_settings.m_receive_buffer_kb > 0) {
+			const int size = n_dtrack.setReceiveBufferSize(n_settings.m_receive_buffer_kb * 1024);
+			UE_LOG(LogDTrackPlugin, Verbose, TEXT("Receive buffer size is %d bytes."), size);
+		}
+
+		if (n_settings.m_busy_poll_us > 0 && !n_dtrack.setBusyPoll(n_settings.m_busy_poll_us)) {
+			UE_LOG(LogDTrackPlugin, Warning, TEXT("Could not enable busy polling, not supported or not permitted."));
+		}
+
+		n_dtrack.setSpinWait(n_settings.m_spin_wait_us);
+	}
+
+	// parse only what is forwarded to LiveLink (bodies, flysticks, hands), skip e.g. markers or covariances sent for other clients
+	unsigned int line_mask = 0;
+	if (n_settings.m_receive_bodies) {
+		line_mask |= DTrackParser::getLineTypeBit(DTrackParser::LINE_6D);
+	}
+	if (n_settings.m_receive_flysticks) {
+		line_mask |= DTrackParser::getLineTypeBit(DTrackParser::LINE_6DF) | DTrackParser::getLineTypeBit(DTrackParser::LINE_6DF2);
+	}
+	if (n_settings.m_receive_hands) {
+		line_mask |= DTrackParser::getLineTypeBit(DTrackParser::LINE_GL);
+	}
+	n_dtrack.setSubscribedLineTypes(line_mask);
+
+	// bodies needed by this instance, others of a shared stream are skipped unparsed
+	n_dtrack.setSubscribedBodies(std::vector<int>(n_settings.m_body_ids.GetData(), n_settings.m_body_ids.GetData() + n_settings.m_body_ids.Num()));
+}
+
+void FDTrackSDKHandler::receive_all_sources(const FDTrackServerSettings& n_settings) {
+
+	// one wait for the data ports of all servers
+	DTrackReactor reactor;
+	TArray<int32> source_indices;  // source index of each reactor source
+
+	reactor.addSource(m_dtrack.Get());
+	source_indices.Add(0);
+	for (int32 i = 0; i < m_dtrack_additional.Num(); i++) {
+		if (reactor.addSource(m_dtrack_additional[i].Get()) >= 0) {
+			source_indices.Add(i + 1);
+		}
+		else {
+			UE_LOG(LogDTrackPlugin, Error, TEXT("Could not receive tracking data, port '%d' is not usable."), n_settings.m_additional_sources[i].m_dtrack_server_port);
+		}
+	}
+
+	bool is_failing = false;
+	while (m_is_active) {
+		const int num_ready = reactor.wait(m_reactor_timeout_us);
+		if (num_ready == -2) {
+			// e.g. a closed socket: wait a bit instead of retrying at once, logged just once
+			if (!is_failing) {
+				UE_LOG(LogDTrackPlugin, Error, TEXT("Could not wait for tracking data, retrying."));
+				is_failing = true;
+			}
+			FPlatformProcess::Sleep(m_reactor_error_delay_us * 1e-6f);
+			continue;
+		}
+		if (num_ready <= 0) {
+			continue;  // timeout, or interrupted by Stop()
+		}
+		is_failing = false;
+
+		for (int32 i = 0; i < reactor.getNumSources(); i++) {
+			DTrackSDK* sdk = reactor.getSource(i);
+			if (reactor.isReady(i) && sdk->receiveAvailable()) {
+				process_frame(*sdk, source_indices[i]);
+			}
+		}
+	}
+}
+
+void FDTrackSDKHandler::process_frame(DTrackSDK& n_dtrack, int32 n_source) {
+
+	uint32 num_dropped = m_dtrack->getNumDroppedPackets();
+	for (const TUniquePtr<DTrackSDK>& sdk : m_dtrack_additional) {
+		num_dropped += sdk->getNumDroppedPackets();
+	}
+	m_num_dropped_frames.Set(static_cast<int32>(num_dropped));
+
+	update_frametime(n_dtrack);
+
+	(this->*m_handle_frame)(n_dtrack, n_source);
+}
 
-	FVector ret;
+template<EDTrackCoordinateSystemType CoordinateSystem>
+void FDTrackSDKHandler::select_frame_handling(const FDTrackServerSettings& n_settings) {
+
+	if (n_settings.m_room_rotation.IsZero() && n_settings.m_room_translation.IsZero()
+		&& n_settings.m_room_scale == 1.0f && n_settings.m_room_mirror_axis == EAxis::None)
+	{
+		m_handle_frame = &FDTrackSDKHandler::handle_frame<CoordinateSystem, false>;
+		return;
+	}
+
+	FRoomTransform& room = m_room_transform;
+
+	// mirroring along one Unreal axis negates that axis for locations, and the other two quaternion axes
+	for (int k = 0; k < 3; k++) {
+		const bool mirrored = (n_settings.m_room_mirror_axis.GetValue() == EAxis::X + k);
+		room.m_hand_scale[k] = mirrored ? -n_settings.m_room_scale : n_settings.m_room_scale;
+		room.m_rotation_signs[k] = (n_settings.m_room_mirror_axis == EAxis::None || mirrored) ? 1.0 : -1.0;
+	}
+
+	room.m_rotation = n_settings.m_room_rotation.Quaternion();
+	room.m_translation = n_settings.m_room_translation;
+
+	// columns of the location matrix are the images of the DTrack axes
+	for (int j = 0; j < 3; j++) {
+		const double axis[3] = { j == 0 ? 1.0 : 0.0, j == 1 ? 1.0 : 0.0, j == 2 ? 1.0 : 0.0 };
+		const FVector mapped = from_dtrack_hand_location<CoordinateSystem, true>(axis);
+		const FVector world = room.m_rotation.RotateVector(mapped);
+
+		room.m_location[0 + j] = world.X;
+		room.m_location[3 + j] = world.Y;
+		room.m_location[6 + j] = world.Z;
+	}
+
+	m_handle_frame = &FDTrackSDKHandler::handle_frame<CoordinateSystem, true>;
+}
+
+template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+void FDTrackSDKHandler::handle_frame(DTrackSDK& n_dtrack, int32 n_source) {
+
+	handle_bodies<CoordinateSystem, RoomTransform>(n_dtrack, n_source);
+	handle_flysticks<CoordinateSystem, RoomTransform>(n_dtrack, n_source);
+	handle_hands<CoordinateSystem, RoomTransform>(n_dtrack, n_source);
+}
+
+// translate a DTrack body location (translation in mm) into Unreal Location (in cm)
+template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+FVector FDTrackSDKHandler::from_dtrack_location(const double(&n_translation)[3]) const {
 
 	// DTrack coordinates come in mm with either Z or Y being up, which has to be configured by the user.
 	// I translate to Unreal's Z being up and cm units.
-	switch (m_server_settings.m_coordinate_system) {
-		default:
-		case EDTrackCoordinateSystemType::CST_Normal:
-			ret.X =  n_translation[0]  / 10.0;
-			ret.Y = -n_translation[1]  / 10.0;
-			ret.Z =  n_translation[2]  / 10.0;
-			break;
-		case EDTrackCoordinateSystemType::CST_Powerwall:
-			ret.X =  n_translation[0]  / 10.0;
-			ret.Y =  n_translation[2]  / 10.0;
-			ret.Z =  n_translation[1]  / 10.0;
-			break;
+	if (!RoomTransform) {
+		return TDTrackRoomAxes<CoordinateSystem>::location(n_translation[0], n_translation[1], n_translation[2]);
+	}
+
+	// axis mapping, mirroring, scale and rotation in one matrix
+	const double* m = m_room_transform.m_location;
+	const FVector& t = m_room_transform.m_translation;
+	return FVector(
+		m[0] * n_translation[0] + m[1] * n_translation[1] + m[2] * n_translation[2] + t.X,
+		m[3] * n_translation[0] + m[4] * n_translation[1] + m[5] * n_translation[2] + t.Y,
+		m[6] * n_translation[0] + m[7] * n_translation[1] + m[8] * n_translation[2] + t.Z);
+}
+
+// translate DTrack locations of several bodies (translation in mm) into Unreal Locations (in cm)
+template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+void FDTrackSDKHandler::from_dtrack_locations(const DTrackPoseArrays& n_poses, TArray<FVector>& out_locations) const {
+
+	// never shrinks, just the first n_poses.num entries are valid
+	if (out_locations.Num() < n_poses.num) {
+		out_locations.SetNumUninitialized(n_poses.num);
 	}
 
-	return ret;
+	const double* x = n_poses.loc_x.data();
+	const double* y = n_poses.loc_y.data();
+	const double* z = n_poses.loc_z.data();
+	FVector* ret = out_locations.GetData();
+
+	for (int32 i = 0; i < n_poses.num; i++) {
+		const double loc[3] = { x[i], y[i], z[i] };
+		ret[i] = from_dtrack_location<CoordinateSystem, RoomTransform>(loc);
+	}
 }
 
 // translate a DTrack 3x3 rotation matrix to Unreal conventions
-FRotator FDTrackSDKHandler::from_dtrack_rotation(const double(&n_matrix)[9]) {
+template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+FQuat FDTrackSDKHandler::from_dtrack_rotation(const double(&n_matrix)[9]) const {
 
-	// ( M[RowIndex][ColumnIndex], DTrack matrix comes column-wise )
-	FMatrix r;
-	r.M[0][0] = n_matrix[0 + 0]; r.M[0][1] = n_matrix[0 + 3]; r.M[0][2] = n_matrix[0 + 6]; r.M[0][3] = 0.0;
-	r.M[1][0] = n_matrix[1 + 0]; r.M[1][1] = n_matrix[1 + 3]; r.M[1][2] = n_matrix[1 + 6]; r.M[1][3] = 0.0;
-	r.M[2][0] = n_matrix[2 + 0]; r.M[2][1] = n_matrix[2 + 3]; r.M[2][2] = n_matrix[2 + 6]; r.M[2][3] = 0.0;
-	r.M[3][0] = 0.0;			 r.M[3][1] = 0.0;			  r.M[3][2] = 0.0;			   r.M[3][3] = 1.0;
+	const FQuat rotation = from_dtrack_hand_rotation<CoordinateSystem, RoomTransform>(n_matrix);
+	return RoomTransform ? m_room_transform.m_rotation * rotation : rotation;
+}
 
-	FMatrix r_adapted;
+// translate DTrack rotations of several bodies into Unreal rotations
+template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+void FDTrackSDKHandler::from_dtrack_rotations(const DTrackPoseArrays& n_poses, TArray<FQuat>& out_rotations) const {
 
-	switch (m_server_settings.m_coordinate_system) {
-	default:
-	case EDTrackCoordinateSystemType::CST_Normal:
-		r_adapted = m_trafo_normal * r * m_trafo_normal_transposed;
-		break;
+	// never shrinks, just the first n_poses.num entries are valid
+	if (out_rotations.Num() < n_poses.num) {
+		out_rotations.SetNumUninitialized(n_poses.num);
+	}
 
-	case EDTrackCoordinateSystemType::CST_Powerwall:
-		r_adapted = m_trafo_powerwall * r * m_trafo_powerwall_transposed;
-		break;
-	}	
+	// quaternions were computed for all entries in one pass when the frame was parsed
+	const double* w = n_poses.quat[0].data();
+	const double* x = n_poses.quat[1].data();
+	const double* y = n_poses.quat[2].data();
+	const double* z = n_poses.quat[3].data();
+	FQuat* ret = out_rotations.GetData();
+
+	if (!RoomTransform) {
+		for (int32 i = 0; i < n_poses.num; i++) {
+			ret[i] = TDTrackRoomAxes<CoordinateSystem>::rotation(w[i], x[i], y[i], z[i]);
+		}
+		return;
+	}
+
+	const double* sign = m_room_transform.m_rotation_signs;
+	const FQuat& room_rotation = m_room_transform.m_rotation;
+	for (int32 i = 0; i < n_poses.num; i++) {
+		const FQuat mapped = TDTrackRoomAxes<CoordinateSystem>::rotation(w[i], x[i], y[i], z[i]);
+		ret[i] = room_rotation * FQuat(sign[0] * mapped.X, sign[1] * mapped.Y, sign[2] * mapped.Z, mapped.W);
+	}
+}
+
+// translate a DTrack 3x3 rotation matrix relative to a hand or finger to Unreal conventions
+template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+FQuat FDTrackSDKHandler::from_dtrack_hand_rotation(const double(&n_matrix)[9]) const {
+
+	// Both room calibrations map DTrack axes to Unreal axes by a permutation with sign flips (a mirroring),
+	// which conjugates the rotation matrix. The rotation angle stays, the axis is mirrored and negated.
+	const DTrackQuaternion quat = rot2quat(n_matrix);
+	const FQuat mapped = TDTrackRoomAxes<CoordinateSystem>::rotation(quat.w, quat.x, quat.y, quat.z);
+	if (!RoomTransform) {
+		return mapped;
+	}
 
-	//r_adapted.Mirror(static_cast<EAxis::Type>(m_server_settings.m_mirror_axis), static_cast<EAxis::Type>(m_server_settings.m_flip_axis));
-	return r_adapted.GetTransposed().Rotator();
+	// the room mirroring conjugates as well
+	const double* sign = m_room_transform.m_rotation_signs;
+	return FQuat(sign[0] * mapped.X, sign[1] * mapped.Y, sign[2] * mapped.Z, mapped.W);
+}
+
+// translate a DTrack location relative to a hand or finger (translation in mm) into Unreal Location (in cm)
+template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+FVector FDTrackSDKHandler::from_dtrack_hand_location(const double(&n_translation)[3]) const {
+
+	const FVector location = TDTrackRoomAxes<CoordinateSystem>::location(n_translation[0], n_translation[1], n_translation[2]);
+	if (!RoomTransform) {
+		return location;
+	}
+
+	// hand space is mirrored and scaled with the room, but not rotated
+	const double* scale = m_room_transform.m_hand_scale;
+	return FVector(location.X * scale[0], location.Y * scale[1], location.Z * scale[2]);
 }
 
 
@@ -535,8 +967,36 @@ FString FDTrackSDKHandler::get_last_error_string() const {
 	else if (m_dtrack->getLastDataError() == DTrackSDK::ERR_TIMEOUT) {
 		return FString(TEXT("Timeout error"));
 	}
+	else if (m_dtrack->getLastDataError() == DTrackSDK::ERR_INTERRUPTED) {
+		return FString(TEXT("Interrupted"));
+	}
 	else {
 		return FString();
 	}
 }
 
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// room transform and conversions called by the automation tests
+template void FDTrackSDKHandler::select_frame_handling<EDTrackCoordinateSystemType::CST_Normal>(const FDTrackServerSettings& n_settings);
+template void FDTrackSDKHandler::select_frame_handling<EDTrackCoordinateSystemType::CST_Powerwall>(const FDTrackServerSettings& n_settings);
+
+#define DTRACK_INSTANTIATE_CONVERSIONS(CoordinateSystem, RoomTransform) \
+	template FQuat FDTrackSDKHandler::from_dtrack_rotation<CoordinateSystem, RoomTransform>(const double(&n_matrix)[9]) const; \
+	template void FDTrackSDKHandler::from_dtrack_rotations<CoordinateSystem, RoomTransform>(const DTrackPoseArrays& n_poses, TArray<FQuat>& out_rotations) const; \
+	template FVector FDTrackSDKHandler::from_dtrack_location<CoordinateSystem, RoomTransform>(const double(&n_translation)[3]) const; \
+	template void FDTrackSDKHandler::from_dtrack_locations<CoordinateSystem, RoomTransform>(const DTrackPoseArrays& n_poses, TArray<FVector>& out_locations) const; \
+	template FQuat FDTrackSDKHandler::from_dtrack_hand_rotation<CoordinateSystem, RoomTransform>(const double(&n_matrix)[9]) const; \
+	template FVector FDTrackSDKHandler::from_dtrack_hand_location<CoordinateSystem, RoomTransform>(const double(&n_translation)[3]) const;
+
+DTRACK_INSTANTIATE_CONVERSIONS(EDTrackCoordinateSystemType::CST_Normal, false)
+DTRACK_INSTANTIATE_CONVERSIONS(EDTrackCoordinateSystemType::CST_Normal, true)
+DTRACK_INSTANTIATE_CONVERSIONS(EDTrackCoordinateSystemType::CST_Powerwall, false)
+DTRACK_INSTANTIATE_CONVERSIONS(EDTrackCoordinateSystemType::CST_Powerwall, true)
+
+#undef DTRACK_INSTANTIATE_CONVERSIONS
+
+template void FDTrackSDKHandler::handle_flysticks<EDTrackCoordinateSystemType::CST_Normal, false>(DTrackSDK& n_dtrack, int32 n_source);
+
+#endif
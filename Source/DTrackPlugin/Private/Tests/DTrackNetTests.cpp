@@ -0,0 +1,135 @@
+// Copyright (c) 2019, Advanced Realtime Tracking GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "CoreMinimal.h"
+
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+
+#include "DTrackNet.hpp"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace DTrackNet;
+
+namespace {
+
+const unsigned int loopback_ip = 0x7f000001;  // 127.0.0.1
+
+// statistics of receiving packets sent in bursts over the loopback interface
+struct FReceiveStatistics {
+	int32 m_num_sent = 0;
+	int32 m_num_received = 0;  // including dropped ones
+	unsigned int m_num_syscalls = 0;
+	double m_receive_time = 0.0;  // time spent receiving, in s
+};
+
+// sends bursts of packets, then receives them with receiveNext() (all packets) or receive() (newest packet only)
+bool receive_bursts(UDP& n_sender, UDP& n_receiver, int32 n_burst, int32 n_num_bursts, bool n_newest_only, FReceiveStatistics& out_stats) {
+
+	char packet[ 200 ];
+	char buffer[ 8192 ];
+	FMemory::Memset(packet, 'x', sizeof(packet));
+
+	out_stats = FReceiveStatistics();
+	n_receiver.resetStatistics();
+
+	for (int32 i = 0; i < n_num_bursts; i++) {
+		for (int32 k = 0; k < n_burst; k++) {
+			if (n_sender.send(packet, sizeof(packet), loopback_ip, n_receiver.getPort(), 100000) != 0) {
+				return false;
+			}
+			out_stats.m_num_sent++;
+		}
+
+		const double start = FPlatformTime::Seconds();
+		if (n_newest_only) {
+			unsigned int num_dropped = 0;
+			if (n_receiver.receive(buffer, sizeof(buffer), 100000, &num_dropped) != int(sizeof(packet))) {
+				return false;
+			}
+		}
+		else {
+			int32 num = 0;
+			while (num < n_burst && n_receiver.receiveNext(buffer, sizeof(buffer), 100000) == int(sizeof(packet))) {
+				num++;
+			}
+			if (num < n_burst) {
+				return false;
+			}
+		}
+		out_stats.m_receive_time += FPlatformTime::Seconds() - start;
+	}
+
+	out_stats.m_num_received = int32(n_receiver.getNumReceivedPackets());
+	out_stats.m_num_syscalls = n_receiver.getNumReceiveSyscalls();
+	return true;
+}
+
+}  // namespace
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDTrackNetReceivePerformanceTest, "DTrack.SDK.Net.ReceivePerformance",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FDTrackNetReceivePerformanceTest::RunTest(const FString& Parameters) {
+
+	net_init();
+
+	{
+		UDP sender(0);
+		UDP receiver(0);
+		if (!TestTrue(TEXT("UDP sockets opened"), sender.isValid() && receiver.isValid())) {
+			net_exit();
+			return false;
+		}
+		receiver.setReceiveBufferSize(1024 * 1024);
+
+		// bursts of several packets, like after a stall of the receiving thread
+		const int32 bursts[] = { 1, 8, 32 };
+		const int32 num_packets = 16384;
+
+		for (int32 burst : bursts) {
+			for (int32 newest_only = 0; newest_only <= 1; newest_only++) {
+				FReceiveStatistics stats;
+				const bool ok = receive_bursts(sender, receiver, burst, num_packets / burst, newest_only != 0, stats);
+				const TCHAR* method = newest_only ? TEXT("receive()") : TEXT("receiveNext()");
+
+				if (!TestTrue(FString::Printf(TEXT("All packets received with %s, bursts of %d packets"), method, burst), ok)) {
+					continue;
+				}
+
+				AddInfo(FString::Printf(TEXT("%s, bursts of %d packets: %.2f system calls and %.2f us per packet"), method, burst,
+					double(stats.m_num_syscalls) / stats.m_num_received, stats.m_receive_time / stats.m_num_received * 1e6));
+			}
+		}
+	}
+
+	net_exit();
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,579 @@
+// Copyright (c) 2019, Advanced Realtime Tracking GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "CoreMinimal.h"
+
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+#include "DTrackParse.hpp"
+
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace DTrackSDK_Parse;
+
+namespace {
+
+// tokens, that are not produced by printf() but have to be handled like strtod() / strtol() / strtoul() does
+const char* const special_tokens[] = {
+	"", "-", "+", ".", "-.", "+.e1", "e5", "abc", "]", " ", " 12", "\t-7",
+	"0", "-0", "+0", "00", "007", "0009.5", "08", "0x", "0x1F", "-0X7fffffff", "0x1.8p1", "0xg",
+	".5", "5.", "-.5e-3", "1e", "1e+", "1E-", "1e5x", "1.5.5", "12]", "3 4",
+	"inf", "-INF", "nan", "-nan", "infinity",
+	"2147483647", "2147483648", "-2147483648", "-2147483649", "4294967295", "4294967296", "-1",
+	"99999999999999999999", "123456789012345678901234567890", "0.1234567890123456789012345",
+	"1e22", "1e23", "9007199254740993", "4.9e-324", "2.2250738585072011e-308", "1.7976931348623157e308",
+	"1e400", "-1e400", "1e-400", "1e00000000000000000000001", "0e99999",
+};
+
+// random number in one of the formats DTrack or printf() may give
+std::string random_token(FRandomStream& n_random) {
+
+	char buf[ 64 ];
+	const double magnitudes[] = { 1e-9, 1e-3, 1.0, 1e3, 1e6, 1e15, 1e300 };
+	const double value = (n_random.FRand() * 2.0 - 1.0) * magnitudes[n_random.RandRange(0, int32(UE_ARRAY_COUNT(magnitudes)) - 1)];
+
+	switch (n_random.RandRange(0, 6)) {
+		case 0:
+			FCStringAnsi::Snprintf(buf, sizeof(buf), "%.*f", n_random.RandRange(0, 9), std::fmod(value, 1e12));
+			break;
+		case 1:
+			FCStringAnsi::Snprintf(buf, sizeof(buf), "%.*e", n_random.RandRange(0, 20), value);
+			break;
+		case 2:
+			FCStringAnsi::Snprintf(buf, sizeof(buf), "%.17g", value);
+			break;
+		case 3:
+			FCStringAnsi::Snprintf(buf, sizeof(buf), "%d", int32(n_random.GetUnsignedInt()));
+			break;
+		case 4:
+			FCStringAnsi::Snprintf(buf, sizeof(buf), n_random.RandRange(0, 1) ? "%u" : "0x%x", n_random.GetUnsignedInt());
+			break;
+		default:
+		{	// random digits, with optional sign, decimal point and exponent
+			std::string token;
+			if (n_random.RandRange(0, 3) == 0) {
+				token += n_random.RandRange(0, 1) ? '-' : '+';
+			}
+			const int32 num_digits = n_random.RandRange(1, 30);
+			const int32 point = n_random.RandRange(-1, num_digits);
+			for (int32 k = 0; k < num_digits; k++) {
+				if (k == point) {
+					token += '.';
+				}
+				token += char('0' + n_random.RandRange(0, 9));
+			}
+			if (n_random.RandRange(0, 2) == 0) {
+				FCStringAnsi::Snprintf(buf, sizeof(buf), "e%d", n_random.RandRange(-330, 330));
+				token += buf;
+			}
+			return token;
+		}
+	}
+	return buf;
+}
+
+// compares string_parse_d(), string_parse_i() and string_parse_ui() with strtod(), strtol() and strtoul() for one token;
+// the token is followed by 'n_next', or the end of the string is given by 'last' and the token is followed by a digit
+bool parse_like_stdlib(const std::string& n_token, char n_next, bool n_bounded, FString& out_error) {
+
+	std::string str = n_token;
+	str += n_bounded ? '7' : n_next;
+	str += " x";
+	const char* first = str.c_str();
+	const char* last = n_bounded ? first + n_token.size() : nullptr;
+
+	// reference works on the token only ("C" locale, as the process doesn't change it)
+	const char* ref = n_token.c_str();
+	char* ref_end;
+
+	// 'double'
+	double d = 0.0;
+	const char* end = string_parse_d(first, last, &d);
+	const double ref_d = strtod(ref, &ref_end);
+	const bool nan_equal = (d != d) && (ref_d != ref_d);
+	if ((end == nullptr) != (ref_end == ref) || (end != nullptr && (end - first != ref_end - ref || (!nan_equal && FMemory::Memcmp(&d, &ref_d, sizeof(d)) != 0)))) {
+		out_error = FString::Printf(TEXT("string_parse_d(\"%s\"): %.17g, %d characters instead of %.17g, %d characters"), ANSI_TO_TCHAR(n_token.c_str()),
+			d, end ? int32(end - first) : -1, ref_d, (ref_end != ref) ? int32(ref_end - ref) : -1);
+		return false;
+	}
+
+	// 'int'
+	int i = 0;
+	end = string_parse_i(first, last, &i);
+	const int ref_i = int(strtol(ref, &ref_end, 0));
+	if ((end == nullptr) != (ref_end == ref) || (end != nullptr && (end - first != ref_end - ref || i != ref_i))) {
+		out_error = FString::Printf(TEXT("string_parse_i(\"%s\"): %d, %d characters instead of %d, %d characters"), ANSI_TO_TCHAR(n_token.c_str()),
+			i, end ? int32(end - first) : -1, ref_i, (ref_end != ref) ? int32(ref_end - ref) : -1);
+		return false;
+	}
+
+	// 'unsigned int'
+	unsigned int ui = 0;
+	end = string_parse_ui(first, last, &ui);
+	const unsigned int ref_ui = (unsigned int)strtoul(ref, &ref_end, 0);
+	if ((end == nullptr) != (ref_end == ref) || (end != nullptr && (end - first != ref_end - ref || ui != ref_ui))) {
+		out_error = FString::Printf(TEXT("string_parse_ui(\"%s\"): %u, %d characters instead of %u, %d characters"), ANSI_TO_TCHAR(n_token.c_str()),
+			ui, end ? int32(end - first) : -1, ref_ui, (ref_end != ref) ? int32(ref_end - ref) : -1);
+		return false;
+	}
+
+	return true;
+}
+
+// line begins found by repeated calls of string_nextline()
+void index_lines_by_nextline(const char* n_str, const char* n_end, std::vector<int>& out_offsets) {
+
+	out_offsets.clear();
+	if (n_str >= n_end) {
+		return;
+	}
+
+	const char* s = n_str;
+	while (s != nullptr) {
+		out_offsets.push_back(int(s - n_str));
+		s = string_nextline(s, n_end);
+	}
+}
+
+// DTrack like packet of the given size, lines ending with CR/LF
+std::string dtrack_packet(FRandomStream& n_random, int32 n_size) {
+
+	std::string packet;
+	char buf[ 64 ];
+	int32 frame = 0;
+	while (int32(packet.size()) < n_size) {
+		FCStringAnsi::Snprintf(buf, sizeof(buf), "fr %d\r\nts 1234.567890\r\n6d 2 ", frame++);
+		packet += buf;
+		for (int32 id = 0; id < 2; id++) {
+			FCStringAnsi::Snprintf(buf, sizeof(buf), "[%d 1.000][%.3f %.3f %.3f 0.000 0.000 0.000]", id,
+				n_random.FRandRange(-3000.f, 3000.f), n_random.FRandRange(-3000.f, 3000.f), n_random.FRandRange(-3000.f, 3000.f));
+			packet += buf;
+		}
+		packet += "\r\n";
+	}
+	packet.resize(n_size);
+	return packet;
+}
+
+// block of a DTrack line, read with a format fixed at compile time and with a format string
+struct FBlockType {
+	const char* m_name;
+	const char* m_format;  // ints go to the int array, doubles to the double array, in this order
+	const char* (*m_read)(const char* n_str, const char* n_end, int* out_idat, double* out_ddat);
+};
+
+const FBlockType block_types[] = {
+	{ "6d/6di/gl [loc]", "ddd",
+		[](const char* n_str, const char* n_end, int* out_idat, double* out_ddat) { return string_get_block<double, 3>(n_str, n_end, out_ddat); } },
+	{ "6d/6df2/6dj/6di/gl [rot]", "ddddddddd",
+		[](const char* n_str, const char* n_end, int* out_idat, double* out_ddat) { return string_get_block<double, 9>(n_str, n_end, out_ddat); } },
+	{ "6d/6dj [id qu]", "id",
+		[](const char* n_str, const char* n_end, int* out_idat, double* out_ddat) { return string_get_block<int, 1, double, 1>(n_str, n_end, out_idat, out_ddat); } },
+	{ "6df2/gl [id qu bt nbt]", "idii",
+		[](const char* n_str, const char* n_end, int* out_idat, double* out_ddat) { return string_get_block<int, 1, double, 1, int, 2>(n_str, n_end, out_idat, out_ddat, out_idat + 1); } },
+	{ "gl [finger]", "dddddd",
+		[](const char* n_str, const char* n_end, int* out_idat, double* out_ddat) { return string_get_block<double, 6>(n_str, n_end, out_ddat); } },
+	{ "6dj [id num]", "ii",
+		[](const char* n_str, const char* n_end, int* out_idat, double* out_ddat) { return string_get_block<int, 2>(n_str, n_end, out_idat); } },
+	{ "6dj [loc ang]", "dddddd",
+		[](const char* n_str, const char* n_end, int* out_idat, double* out_ddat) { return string_get_block<double, 3, double, 3>(n_str, n_end, out_ddat, out_ddat + 3); } },
+	{ "6di [id st err]", "iid",
+		[](const char* n_str, const char* n_end, int* out_idat, double* out_ddat) { return string_get_block<int, 2, double, 1>(n_str, n_end, out_idat, out_ddat); } },
+};
+
+// valid block of the given format, values in the formats DTrack gives
+std::string random_block(FRandomStream& n_random, const char* n_format) {
+
+	std::string block = "[";
+	char buf[ 32 ];
+	for (const char* f = n_format; *f != '\0'; f++) {
+		if (f != n_format) {
+			block += ' ';
+		}
+		if (*f == 'i') {
+			FCStringAnsi::Snprintf(buf, sizeof(buf), "%d", n_random.RandRange(-1, 999));
+		}
+		else {
+			FCStringAnsi::Snprintf(buf, sizeof(buf), "%.*f", n_random.RandRange(0, 6), n_random.FRandRange(-3000.f, 3000.f));
+		}
+		block += buf;
+	}
+	block += ']';
+	return block;
+}
+
+// malformed variant of a block: missing brackets, missing or additional values, invalid characters, ...
+std::string malformed_block(FRandomStream& n_random, std::string n_block) {
+
+	const int32 pos = n_random.RandRange(0, int32(n_block.size()) - 1);
+	switch (n_random.RandRange(0, 7)) {
+		case 0:  n_block.erase(0, 1);  break;  // missing '['
+		case 1:  n_block.erase(n_block.size() - 1);  break;  // missing ']'
+		case 2:  n_block.erase(n_block.rfind(' ') == std::string::npos ? 1 : n_block.rfind(' '));  n_block += ']';  break;  // value missing
+		case 3:  n_block.insert(n_block.size() - 1, " 42 7.5");  break;  // additional values
+		case 4:  n_block[pos] = 'x';  break;  // invalid character
+		case 5:  n_block.insert(pos, 1, ']');  break;  // block ends early
+		case 6:  n_block = "[]";  break;  // empty
+		default:  n_block.insert(pos, n_random.RandRange(0, 1) ? "\t " : " ");  break;  // more white space
+	}
+	return n_block;
+}
+
+// compares reading a block with the template and with the format string;
+// the block is followed by another one, or its end is given by 'end' (also inside the block)
+bool template_block_like_format(const FBlockType& n_type, const std::string& n_block, int32 n_end_pos, FString& out_error) {
+
+	const std::string str = n_block + " [1 2]";
+	const char* first = str.c_str();
+	const char* end = (n_end_pos >= 0) ? first + n_end_pos : nullptr;
+
+	int idat[ 16 ] = {};
+	double ddat[ 16 ] = {};
+	int ref_idat[ 16 ] = {};
+	double ref_ddat[ 16 ] = {};
+
+	const char* s = n_type.m_read(first, end, idat, ddat);
+	const char* ref_s = string_get_block(first, end, n_type.m_format, ref_idat, nullptr, ref_ddat);
+
+	bool equal = (s == ref_s);
+	if (equal && s != nullptr) {
+		equal = FMemory::Memcmp(idat, ref_idat, sizeof(idat)) == 0 && FMemory::Memcmp(ddat, ref_ddat, sizeof(ddat)) == 0;
+	}
+	if (!equal) {
+		out_error = FString::Printf(TEXT("%s \"%s\" (end %d): %d characters instead of %d characters"), ANSI_TO_TCHAR(n_type.m_name),
+			ANSI_TO_TCHAR(n_block.c_str()), n_end_pos, s ? int32(s - first) : -1, ref_s ? int32(ref_s - first) : -1);
+	}
+	return equal;
+}
+
+}  // namespace
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDTrackParseNumbersTest, "DTrack.SDK.Parse.Numbers",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDTrackParseNumbersTest::RunTest(const FString& Parameters) {
+
+	// all tokens with the different ends of a number: white space, end of block, end of string, end given by 'last'
+	const char nexts[] = { ' ', ']', '\0' };
+	const int32 num_nexts = UE_ARRAY_COUNT(nexts);
+
+	TArray<std::string> tokens;
+	for (const char* token : special_tokens) {
+		tokens.Add(token);
+	}
+
+	FRandomStream random(2021);
+	for (int32 i = 0; i < 20000; i++) {
+		tokens.Add(random_token(random));
+	}
+
+	int32 num_differing = 0;
+	for (const std::string& token : tokens) {
+		for (int32 k = 0; k <= num_nexts; k++) {
+			FString error;
+			const bool bounded = (k == num_nexts);
+			if (!parse_like_stdlib(token, bounded ? '\0' : nexts[k], bounded, error)) {
+				if (num_differing++ < 10) {
+					AddError(error);
+				}
+			}
+		}
+	}
+	TestEqual(TEXT("Numbers parsed differently from the standard library"), num_differing, 0);
+
+	// numbers too long for the fallback are an error, instead of being parsed in parts
+	const std::string long_integers[] = {
+		std::string(70, '1'),
+		std::string("-") + std::string(65, '9'),
+		std::string("0x") + std::string(64, 'f'),
+	};
+	for (const std::string& number : long_integers) {
+		const std::string str = number + " 1";
+		int i;
+		unsigned int ui;
+		TestTrue(FString::Printf(TEXT("string_parse_i() rejecting number with %d characters"), int32(number.size())),
+			string_parse_i(str.c_str(), nullptr, &i) == nullptr);
+		TestTrue(FString::Printf(TEXT("string_parse_ui() rejecting number with %d characters"), int32(number.size())),
+			string_parse_ui(str.c_str(), nullptr, &ui) == nullptr);
+	}
+
+	const std::string long_doubles[] = {
+		std::string(70, '1'),
+		std::string("0.") + std::string(70, '0') + "1",
+		std::string("-") + std::string(65, '9') + ".5",
+	};
+	for (const std::string& number : long_doubles) {
+		const std::string str = number + " 1";
+		double d;
+		TestTrue(FString::Printf(TEXT("string_parse_d() rejecting number with %d characters"), int32(number.size())),
+			string_parse_d(str.c_str(), nullptr, &d) == nullptr);
+	}
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDTrackParseNumbersPerformanceTest, "DTrack.SDK.Parse.NumbersPerformance",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FDTrackParseNumbersPerformanceTest::RunTest(const FString& Parameters) {
+
+	// numbers like in a '6d' line: locations in mm with 3 decimals, rotation matrix with 6 decimals, ids
+	const int32 num = 100000;
+	const int32 num_runs = 5;
+
+	std::string str;
+	FRandomStream random(2021);
+	for (int32 i = 0; i < num; i++) {
+		char buf[ 32 ];
+		switch (i % 4) {
+			case 0:  FCStringAnsi::Snprintf(buf, sizeof(buf), "%d ", random.RandRange(0, 99));  break;
+			case 1:  FCStringAnsi::Snprintf(buf, sizeof(buf), "%.3f ", random.FRandRange(-3000.f, 3000.f));  break;
+			default:  FCStringAnsi::Snprintf(buf, sizeof(buf), "%.6f ", random.FRandRange(-1.f, 1.f));  break;
+		}
+		str += buf;
+	}
+	const char* first = str.c_str();
+	const char* last = first + str.size();
+
+	double best_parse = DBL_MAX;
+	double best_strtod = DBL_MAX;
+	double sum_parse = 0.0;
+	double sum_strtod = 0.0;
+	for (int32 run = 0; run < num_runs; run++) {
+		double start = FPlatformTime::Seconds();
+		const char* s = first;
+		for (int32 i = 0; i < num; i++) {
+			double d;
+			s = string_parse_d(s, last, &d);
+			sum_parse += d;
+		}
+		best_parse = FMath::Min(best_parse, FPlatformTime::Seconds() - start);
+
+		start = FPlatformTime::Seconds();
+		char* e = const_cast<char*>(first);
+		for (int32 i = 0; i < num; i++) {
+			sum_strtod += strtod(e, &e);
+		}
+		best_strtod = FMath::Min(best_strtod, FPlatformTime::Seconds() - start);
+	}
+
+	TestEqual(TEXT("Sum of numbers parsed by string_parse_d() and strtod()"), sum_parse, sum_strtod);
+
+	AddInfo(FString::Printf(TEXT("string_parse_d(): %.1f million numbers per second"), num / best_parse * 1e-6));
+	AddInfo(FString::Printf(TEXT("strtod(): %.1f million numbers per second"), num / best_strtod * 1e-6));
+
+	return true;
+}
+
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDTrackParseLineIndexTest, "DTrack.SDK.Parse.LineIndex",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDTrackParseLineIndexTest::RunTest(const FString& Parameters) {
+
+	// mostly CR/LF, so all combinations of '\r', '\n' and "\r\n" occur, also at the borders of the 16/32 byte blocks
+	const char chars[] = { '\r', '\n', '\r', '\n', 'a', ' ', '\0' };
+	const int32 num_chars = UE_ARRAY_COUNT(chars);
+
+	FRandomStream random(2021);
+	std::vector<char> buffer(256 + 32);
+	std::vector<int> offsets;
+	std::vector<int> expected_offsets;
+	int32 num_differing = 0;
+
+	for (int32 i = 0; i < 20000; i++) {
+		// sizes around the block size, at different alignments
+		const int32 size = (i % 4 == 0) ? random.RandRange(0, 256) : 16 * random.RandRange(0, 8) + random.RandRange(-1, 1);
+		const int32 align = random.RandRange(0, 31);
+		if (size < 0) {
+			continue;
+		}
+
+		char* str = buffer.data() + align;
+		for (int32 k = 0; k < size; k++) {
+			str[k] = chars[random.RandRange(0, num_chars - 1)];
+		}
+		if (i % 3 == 0 && size > 0) {
+			// CR/LF at the end of a block, followed by the begin of a line in the next one
+			const int32 block_end = FMath::Min(size, 16 * random.RandRange(1, 8)) - 1;
+			str[block_end] = random.RandRange(0, 1) ? '\n' : '\r';
+		}
+
+		const int num_lines = string_index_lines(str, str + size, offsets);
+		index_lines_by_nextline(str, str + size, expected_offsets);
+
+		if (num_lines != int(offsets.size()) || offsets != expected_offsets) {
+			if (num_differing++ < 10) {
+				AddError(FString::Printf(TEXT("Line index of %d characters: %d lines instead of %d"), size, num_lines, int32(expected_offsets.size())));
+			}
+		}
+	}
+	TestEqual(TEXT("Line indexes differing from string_nextline()"), num_differing, 0);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDTrackParseLineIndexPerformanceTest, "DTrack.SDK.Parse.LineIndexPerformance",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FDTrackParseLineIndexPerformanceTest::RunTest(const FString& Parameters) {
+
+	const int32 sizes[] = { 1024, 8 * 1024, 64 * 1024 };
+	const int32 total_size = 64 * 1024 * 1024;  // per packet size and method
+
+	FRandomStream random(2021);
+	std::vector<int> offsets;
+	offsets.reserve(64 * 1024);
+
+	for (int32 size : sizes) {
+		const std::string packet = dtrack_packet(random, size);
+		const char* str = packet.data();
+		const char* end = str + packet.size();
+		const int32 num_runs = total_size / size;
+
+		double start = FPlatformTime::Seconds();
+		int64 num_index = 0;
+		for (int32 run = 0; run < num_runs; run++) {
+			num_index += string_index_lines(str, end, offsets);
+		}
+		const double time_index = FPlatformTime::Seconds() - start;
+
+		start = FPlatformTime::Seconds();
+		int64 num_nextline = 0;
+		for (int32 run = 0; run < num_runs; run++) {
+			for (const char* s = str; s != nullptr; s = string_nextline(s, end)) {
+				num_nextline++;
+			}
+		}
+		const double time_nextline = FPlatformTime::Seconds() - start;
+
+		TestEqual(FString::Printf(TEXT("Lines found in %d KB packets"), size / 1024), num_index, num_nextline);
+
+		AddInfo(FString::Printf(TEXT("%d KB packet: string_index_lines() %.0f MB/s, string_nextline() %.0f MB/s"), size / 1024,
+			total_size / time_index * 1e-6, total_size / time_nextline * 1e-6));
+	}
+
+	return true;
+}
+
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDTrackParseBlocksTest, "DTrack.SDK.Parse.Blocks",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDTrackParseBlocksTest::RunTest(const FString& Parameters) {
+
+	FRandomStream random(2021);
+	int32 num_differing = 0;
+
+	for (const FBlockType& type : block_types) {
+		for (int32 i = 0; i < 2000; i++) {
+			std::string block = random_block(random, type.m_format);
+			if (i % 2 == 1) {
+				block = malformed_block(random, block);
+			}
+
+			// end of string by '\0', or given by 'end' behind or inside of the block
+			const int32 end_pos = (i % 5 == 0) ? random.RandRange(0, int32(block.size())) : -1;
+
+			FString error;
+			if (!template_block_like_format(type, block, end_pos, error)) {
+				if (num_differing++ < 10) {
+					AddError(error);
+				}
+			}
+		}
+	}
+	TestEqual(TEXT("Blocks read differently with template and format string"), num_differing, 0);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDTrackParseBlocksPerformanceTest, "DTrack.SDK.Parse.BlocksPerformance",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FDTrackParseBlocksPerformanceTest::RunTest(const FString& Parameters) {
+
+	const int32 num = 10000;
+	const int32 num_runs = 20;
+
+	FRandomStream random(2021);
+	int idat[ 16 ];
+	double ddat[ 16 ];
+
+	for (const FBlockType& type : block_types) {
+		std::string str;
+		for (int32 i = 0; i < num; i++) {
+			str += random_block(random, type.m_format);
+		}
+		const char* first = str.c_str();
+		const char* end = first + str.size();
+
+		double best_template = DBL_MAX;
+		double best_format = DBL_MAX;
+		bool all_read = true;
+		for (int32 run = 0; run < num_runs; run++) {
+			double start = FPlatformTime::Seconds();
+			const char* s = first;
+			for (int32 i = 0; i < num && s != nullptr; i++) {
+				s = type.m_read(s, end, idat, ddat);
+			}
+			best_template = FMath::Min(best_template, FPlatformTime::Seconds() - start);
+			all_read = all_read && (s == end);
+
+			start = FPlatformTime::Seconds();
+			s = first;
+			for (int32 i = 0; i < num && s != nullptr; i++) {
+				s = string_get_block(s, end, type.m_format, idat, nullptr, ddat);
+			}
+			best_format = FMath::Min(best_format, FPlatformTime::Seconds() - start);
+			all_read = all_read && (s == end);
+		}
+
+		TestTrue(FString::Printf(TEXT("All blocks read (%s)"), ANSI_TO_TCHAR(type.m_name)), all_read);
+
+		AddInfo(FString::Printf(TEXT("%s: template %.1f ns per block, format string %.1f ns per block"), ANSI_TO_TCHAR(type.m_name),
+			best_template / num * 1e9, best_format / num * 1e9));
+	}
+
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
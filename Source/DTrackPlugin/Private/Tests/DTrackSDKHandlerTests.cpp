@@ -0,0 +1,909 @@
+// Copyright (c) 2019, Advanced Realtime Tracking GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "DTrackSDKHandler.h"
+#include "DTrackLiveLinkSource.h"
+#include "DTrackLiveLinkRole.h"
+#include "DTrackLiveLinkTypes.h"
+
+#include "Misc/AutomationTest.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Math/RandomStream.h"
+
+#include <cmath>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Access to the protected members of FDTrackSDKHandler for the tests
+ */
+struct FDTrackSDKHandlerTestAccess
+{
+	template<EDTrackCoordinateSystemType CoordinateSystem>
+	static void select_frame_handling(FDTrackSDKHandler& n_handler, const FDTrackServerSettings& n_settings) {
+		n_handler.select_frame_handling<CoordinateSystem>(n_settings);
+	}
+
+	// conversions with RoomTransform use the room transform set by select_frame_handling()
+	template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform = false>
+	static void from_dtrack_rotations(const FDTrackSDKHandler& n_handler, const DTrackPoseArrays& n_poses, TArray<FQuat>& out_rotations) {
+		n_handler.from_dtrack_rotations<CoordinateSystem, RoomTransform>(n_poses, out_rotations);
+	}
+
+	template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+	static void from_dtrack_locations(const FDTrackSDKHandler& n_handler, const DTrackPoseArrays& n_poses, TArray<FVector>& out_locations) {
+		n_handler.from_dtrack_locations<CoordinateSystem, RoomTransform>(n_poses, out_locations);
+	}
+
+	template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+	static FQuat from_dtrack_rotation(const FDTrackSDKHandler& n_handler, const double(&n_matrix)[9]) {
+		return n_handler.from_dtrack_rotation<CoordinateSystem, RoomTransform>(n_matrix);
+	}
+
+	template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+	static FVector from_dtrack_location(const FDTrackSDKHandler& n_handler, const double(&n_translation)[3]) {
+		return n_handler.from_dtrack_location<CoordinateSystem, RoomTransform>(n_translation);
+	}
+
+	template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+	static FQuat from_dtrack_hand_rotation(const FDTrackSDKHandler& n_handler, const double(&n_matrix)[9]) {
+		return n_handler.from_dtrack_hand_rotation<CoordinateSystem, RoomTransform>(n_matrix);
+	}
+
+	template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+	static FVector from_dtrack_hand_location(const FDTrackSDKHandler& n_handler, const double(&n_translation)[3]) {
+		return n_handler.from_dtrack_hand_location<CoordinateSystem, RoomTransform>(n_translation);
+	}
+
+	template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+	static void handle_flysticks(FDTrackSDKHandler& n_handler, DTrackSDK& n_dtrack, int32 n_source) {
+		n_handler.handle_flysticks<CoordinateSystem, RoomTransform>(n_dtrack, n_source);
+	}
+
+	// computes the joint poses of the fingers of all hands (fingers of the hands one after another, in hand space before)
+	static void compute_finger_poses(FDTrackSDKHandler& n_handler, const TArray<DTrackHand>& n_hands, const TArray<FTransform>& n_hand_transforms,
+		const FVector& n_finger_axis_x, const FVector& n_finger_axis_z, TArray<FDTrackFinger>& inout_fingers) {
+
+		n_handler.m_hand_poses.Reset();
+		int32 first_finger = 0;
+		for (int32 i = 0; i < n_hands.Num(); i++) {
+			FDTrackSDKHandler::FHandPose& hand_pose = n_handler.m_hand_poses[n_handler.m_hand_poses.AddUninitialized()];
+			hand_pose.m_hand = &n_hands[i];
+			hand_pose.m_transform = n_hand_transforms[i];
+			hand_pose.m_first_finger = first_finger;
+			first_finger += n_hands[i].nfinger;
+		}
+
+		n_handler.m_fingers = inout_fingers;
+		n_handler.compute_finger_poses(n_finger_axis_x, n_finger_axis_z);
+		inout_fingers = n_handler.m_fingers;
+	}
+};
+
+namespace {
+
+// Rotation between two quaternions in degrees, also precise for small angles (unlike FQuat::AngularDistance)
+double angle_between(const FQuat& n_a, const FQuat& n_b) {
+
+	const FQuat diff = n_a.Inverse() * n_b;
+	const double sin_half = std::sqrt(double(diff.X) * diff.X + double(diff.Y) * diff.Y + double(diff.Z) * diff.Z);
+	return FMath::RadiansToDegrees(2.0 * std::atan2(sin_half, std::abs(double(diff.W))));
+}
+
+// DTrack rotation matrix (column-wise) of a random rotation, uniformly distributed
+void random_rotation(FRandomStream& n_random, double(&out_matrix)[9]) {
+
+	double q[4];
+	double norm2;
+	do {
+		for (int k = 0; k < 4; k++) {
+			q[k] = n_random.FRandRange(-1.f, 1.f);
+		}
+		norm2 = q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+	} while (norm2 < 0.01 || norm2 > 1.0);
+
+	// in double precision, so the matrix is orthonormal to double precision as well
+	const double s = 1.0 / std::sqrt(norm2);
+	const double w = q[0] * s, x = q[1] * s, y = q[2] * s, z = q[3] * s;
+
+	out_matrix[0] = 1.0 - 2.0 * (y * y + z * z); out_matrix[3] = 2.0 * (x * y - z * w);       out_matrix[6] = 2.0 * (x * z + y * w);
+	out_matrix[1] = 2.0 * (x * y + z * w);       out_matrix[4] = 1.0 - 2.0 * (x * x + z * z); out_matrix[7] = 2.0 * (y * z - x * w);
+	out_matrix[2] = 2.0 * (x * z - y * w);       out_matrix[5] = 2.0 * (y * z + x * w);       out_matrix[8] = 1.0 - 2.0 * (x * x + y * y);
+}
+
+// pose arrays of random rotations
+void random_pose_arrays(FRandomStream& n_random, int32 n_num, DTrackPoseArrays& out_poses) {
+
+	out_poses.num = n_num;
+	for (int k = 0; k < 9; k++) {
+		out_poses.rot[k].resize(n_num);
+	}
+
+	for (int32 i = 0; i < n_num; i++) {
+		double rot[9];
+		random_rotation(n_random, rot);
+		for (int k = 0; k < 9; k++) {
+			out_poses.rot[k][i] = rot[k];
+		}
+	}
+}
+
+// Conversion of DTrack rotation matrices before the quaternion kernel, through FMatrix and FRotator
+FQuat matrix_path_rotation(EDTrackCoordinateSystemType n_coordinate_system, const double(&n_matrix)[9]) {
+
+	static const FMatrix trafo_normal = FMatrix(
+		  FPlane( 1.0f,  0.0f, 0.0f, 0.0f )
+		, FPlane( 0.0f, -1.0f, 0.0f, 0.0f )
+		, FPlane( 0.0f,  0.0f, 1.0f, 0.0f )
+		, FPlane( 0.0f,  0.0f, 0.0f, 1.0f ));
+
+	static const FMatrix trafo_powerwall = FMatrix(
+		  FPlane( 1.0f, 0.0f,  0.0f, 0.0f )
+		, FPlane( 0.0f, 0.0f,  1.0f, 0.0f )
+		, FPlane( 0.0f, 1.0f,  0.0f, 0.0f )
+		, FPlane( 0.0f, 0.0f,  0.0f, 1.0f ));
+
+	// ( M[RowIndex][ColumnIndex], DTrack matrix comes column-wise )
+	FMatrix r;
+	r.M[0][0] = n_matrix[0 + 0]; r.M[0][1] = n_matrix[0 + 3]; r.M[0][2] = n_matrix[0 + 6]; r.M[0][3] = 0.0;
+	r.M[1][0] = n_matrix[1 + 0]; r.M[1][1] = n_matrix[1 + 3]; r.M[1][2] = n_matrix[1 + 6]; r.M[1][3] = 0.0;
+	r.M[2][0] = n_matrix[2 + 0]; r.M[2][1] = n_matrix[2 + 3]; r.M[2][2] = n_matrix[2 + 6]; r.M[2][3] = 0.0;
+	r.M[3][0] = 0.0;			 r.M[3][1] = 0.0;			  r.M[3][2] = 0.0;			   r.M[3][3] = 1.0;
+
+	const FMatrix& trafo = (n_coordinate_system == EDTrackCoordinateSystemType::CST_Powerwall) ? trafo_powerwall : trafo_normal;
+	const FMatrix r_adapted = trafo * r * trafo.GetTransposed();
+
+	return r_adapted.GetTransposed().Rotator().Quaternion();
+}
+
+// random rotation, uniformly distributed
+FQuat random_quat(FRandomStream& n_random) {
+
+	FQuat q;
+	float norm2;
+	do {
+		q = FQuat(n_random.FRandRange(-1.f, 1.f), n_random.FRandRange(-1.f, 1.f), n_random.FRandRange(-1.f, 1.f), n_random.FRandRange(-1.f, 1.f));
+		norm2 = q.SizeSquared();
+	} while (norm2 < 0.01f || norm2 > 1.0f);
+
+	q.Normalize();
+	return q;
+}
+
+// DTrack location in hand or finger space (mm) to Unreal (cm), for the normal room calibration
+FVector finger_space_location(const double(&n_translation)[3]) {
+
+	return FVector(n_translation[0] / 10.0, -n_translation[1] / 10.0, n_translation[2] / 10.0);
+}
+
+// Joint poses of one finger as computed before compute_finger_poses(), through FRotator, one finger at a time
+void compute_finger_joint_pose(
+	const FTransform& n_hand_transform, FDTrackFinger& out_finger, const float finger_x_rotation,
+	const float finger_y_rotation, const float finger_z_rotation)
+{
+	double dtrack_finger_space_loc[3];
+
+	// first joint (in finger coordinate system)
+	dtrack_finger_space_loc[0] = -out_finger.m_outer_phalanx_length;
+	dtrack_finger_space_loc[1] = dtrack_finger_space_loc[2] = 0.0;
+	const FVector finger_space_location_outerphalanx = finger_space_location(dtrack_finger_space_loc);
+
+	//Convert outer phalanx to hand space
+	const FVector hand_space_outerphalanx_location = out_finger.m_tip_transform.TransformPosition(finger_space_location_outerphalanx);
+	const FQuat hand_space_outerphalanx_rotation = out_finger.m_tip_transform.GetRotation() * FRotator(finger_x_rotation, finger_y_rotation, finger_z_rotation).Quaternion();
+
+	//Convert outer phalanx to world space
+	out_finger.m_outer_phalanx_transform.SetLocation(n_hand_transform.TransformPosition(hand_space_outerphalanx_location));
+	out_finger.m_outer_phalanx_transform.SetRotation(n_hand_transform.TransformRotation(hand_space_outerphalanx_rotation));
+
+	// second joint (in finger coordinate system)
+	dtrack_finger_space_loc[0] = -out_finger.m_outer_phalanx_length - out_finger.m_middle_phalanx_length * cos(out_finger.m_middle_outer_phalanx_angle * PI / 180.0);
+	dtrack_finger_space_loc[1] = 0.0;
+	dtrack_finger_space_loc[2] = out_finger.m_middle_phalanx_length * sin(out_finger.m_middle_outer_phalanx_angle * PI / 180.0);
+	const FVector finger_space_location_middlephalanx = finger_space_location(dtrack_finger_space_loc);
+	const FQuat finger_space_rotation_middlephalanx = FQuat(FVector(0.0f, 1.0f, 0.0f), out_finger.m_middle_outer_phalanx_angle * PI / 180.f).Rotator().Add(finger_x_rotation, finger_y_rotation, finger_z_rotation).Quaternion();
+
+	//Convert middle phalanx to hand space
+	const FVector hand_space_middlephalanx_location = out_finger.m_tip_transform.TransformPosition(finger_space_location_middlephalanx);
+	const FQuat hand_space_middlephalanx_rotation = out_finger.m_tip_transform.TransformRotation(finger_space_rotation_middlephalanx);
+
+	//Convert middle phalanx to world space
+	out_finger.m_middle_phalanx_transform.SetLocation(n_hand_transform.TransformPosition(hand_space_middlephalanx_location));
+	out_finger.m_middle_phalanx_transform.SetRotation(n_hand_transform.TransformRotation(hand_space_middlephalanx_rotation));
+
+	// third joint (in finger coordinate system)
+	dtrack_finger_space_loc[0] = -out_finger.m_outer_phalanx_length
+		- out_finger.m_middle_phalanx_length * cos(out_finger.m_middle_outer_phalanx_angle * PI / 180.0)
+		- out_finger.m_inner_phalanx_length * cos((out_finger.m_middle_outer_phalanx_angle + out_finger.m_inner_middle_phalanx_angle) * PI / 180.0);
+	dtrack_finger_space_loc[1] = 0.0;
+	dtrack_finger_space_loc[2] = out_finger.m_middle_phalanx_length * sin(out_finger.m_middle_outer_phalanx_angle * PI / 180.0)
+		+ out_finger.m_inner_phalanx_length * sin((out_finger.m_middle_outer_phalanx_angle + out_finger.m_inner_middle_phalanx_angle) * PI / 180.0);
+	const FVector finger_space_location_innerphalanx = finger_space_location(dtrack_finger_space_loc);
+	const FQuat finger_space_rotation_innerphalanx = FQuat(FVector(0.0f, 1.0f, 0.0f), (out_finger.m_middle_outer_phalanx_angle + out_finger.m_inner_middle_phalanx_angle) * PI / 180.0).Rotator().Add(finger_x_rotation, finger_y_rotation, finger_z_rotation).Quaternion();
+
+	// Convert inner phalanx to hand space
+	const FVector hand_space_innerphalanx_location = out_finger.m_tip_transform.TransformPosition(finger_space_location_innerphalanx);
+	const FQuat hand_space_innerphalanx_rotation = out_finger.m_tip_transform.TransformRotation(finger_space_rotation_innerphalanx);
+
+	// Convert inner phalanx to world space
+	out_finger.m_inner_phalanx_transform.SetLocation(n_hand_transform.TransformPosition(hand_space_innerphalanx_location));
+	out_finger.m_inner_phalanx_transform.SetRotation(n_hand_transform.TransformRotation(hand_space_innerphalanx_rotation));
+
+	// Finger tip is already in hand space and hand is in world space
+	out_finger.m_tip_transform = out_finger.m_tip_transform * n_hand_transform;
+}
+
+// true if a phalanx is rotated by close to +-90 degrees, where FRotator of the previous computation is at its singularity
+bool is_near_gimbal_lock(float n_middle_outer_angle, float n_inner_middle_angle) {
+
+	return FMath::Abs(FMath::Abs(n_middle_outer_angle) - 90.f) < 10.f
+		|| FMath::Abs(FMath::Abs(n_middle_outer_angle + n_inner_middle_angle) - 90.f) < 10.f;
+}
+
+// hands in a room of 2 x 2 x 1 m, alternating left and right, with fingers in hand space
+void random_hands(FRandomStream& n_random, int32 n_num_hands, int32 n_num_fingers,
+	TArray<DTrackHand>& out_hands, TArray<FTransform>& out_hand_transforms, TArray<FDTrackFinger>& out_fingers) {
+
+	for (int32 i = 0; i < n_num_hands; i++) {
+		DTrackHand& hand = out_hands.AddZeroed_GetRef();
+		hand.id = i;
+		hand.lr = i % 2;
+		hand.nfinger = n_num_fingers;
+
+		out_hand_transforms.Add(FTransform(random_quat(n_random),
+			FVector(n_random.FRandRange(-100.f, 100.f), n_random.FRandRange(-100.f, 100.f), n_random.FRandRange(0.f, 100.f))));
+
+		for (int32 j = 0; j < n_num_fingers; j++) {
+			FDTrackFinger& finger = out_fingers.AddDefaulted_GetRef();
+			finger.m_tip_transform = FTransform(random_quat(n_random),
+				FVector(n_random.FRandRange(-10.f, 10.f), n_random.FRandRange(-10.f, 10.f), n_random.FRandRange(-10.f, 10.f)));
+			finger.m_outer_phalanx_length = n_random.FRandRange(15.f, 30.f);
+			finger.m_middle_phalanx_length = n_random.FRandRange(20.f, 35.f);
+			finger.m_inner_phalanx_length = n_random.FRandRange(30.f, 50.f);
+			do {
+				finger.m_middle_outer_phalanx_angle = n_random.FRandRange(-20.f, 120.f);
+				finger.m_inner_middle_phalanx_angle = n_random.FRandRange(-20.f, 120.f);
+			} while (is_near_gimbal_lock(finger.m_middle_outer_phalanx_angle, finger.m_inner_middle_phalanx_angle));
+		}
+	}
+}
+
+// Joint poses of the fingers of all hands as computed before compute_finger_poses()
+void compute_finger_joint_poses(const TArray<DTrackHand>& n_hands, const TArray<FTransform>& n_hand_transforms, TArray<FDTrackFinger>& inout_fingers) {
+
+	int32 finger = 0;
+	for (int32 i = 0; i < n_hands.Num(); i++) {
+		for (int32 j = 0; j < n_hands[i].nfinger; j++, finger++) {
+			if (n_hands[i].lr == 0) {
+				compute_finger_joint_pose(n_hand_transforms[i], inout_fingers[finger], 0.f, 0.f, -90.f);
+			}
+			else {
+				compute_finger_joint_pose(n_hand_transforms[i], inout_fingers[finger], 180.f, 0.f, -90.f);
+			}
+		}
+	}
+}
+
+// location mirrored along one Unreal axis
+FVector mirror_location(const FVector& n_location, EAxis::Type n_axis) {
+
+	return FVector(n_axis == EAxis::X ? -n_location.X : n_location.X,
+		n_axis == EAxis::Y ? -n_location.Y : n_location.Y,
+		n_axis == EAxis::Z ? -n_location.Z : n_location.Z);
+}
+
+// determinant of the linear part of a location conversion, from the images of the DTrack axes (1 m each)
+template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+double location_determinant(const FDTrackSDKHandler& n_handler) {
+
+	static const double origin[3] = { 0.0, 0.0, 0.0 };
+	static const double axes[3][3] = { { 1000.0, 0.0, 0.0 }, { 0.0, 1000.0, 0.0 }, { 0.0, 0.0, 1000.0 } };
+
+	const FVector o = FDTrackSDKHandlerTestAccess::from_dtrack_location<CoordinateSystem, RoomTransform>(n_handler, origin);
+	const FVector x = FDTrackSDKHandlerTestAccess::from_dtrack_location<CoordinateSystem, RoomTransform>(n_handler, axes[0]) - o;
+	const FVector y = FDTrackSDKHandlerTestAccess::from_dtrack_location<CoordinateSystem, RoomTransform>(n_handler, axes[1]) - o;
+	const FVector z = FDTrackSDKHandlerTestAccess::from_dtrack_location<CoordinateSystem, RoomTransform>(n_handler, axes[2]) - o;
+	return FVector::DotProduct(FVector::CrossProduct(x, y), z);
+}
+
+// Checks the room transform of one room calibration and mirror axis: locations are mapped, scaled and mirrored
+// in Unreal axes, then rotated and translated; rotations stay proper rotations, conjugated by the mirroring.
+template<EDTrackCoordinateSystemType CoordinateSystem>
+void test_room_transform(FAutomationTestBase& n_test, const TCHAR* n_name, EAxis::Type n_mirror_axis, FRandomStream& n_random) {
+
+	typedef FDTrackSDKHandlerTestAccess Access;
+
+	FDTrackServerSettings settings;
+	settings.m_coordinate_system = CoordinateSystem;
+	settings.m_room_rotation = FRotator(30.f, -50.f, 70.f);
+	settings.m_room_translation = FVector(120.f, -80.f, 40.f);
+	settings.m_room_scale = 2.5f;
+	settings.m_room_mirror_axis = n_mirror_axis;
+
+	FDTrackSDKHandler handler(nullptr);
+	Access::select_frame_handling<CoordinateSystem>(handler, settings);
+
+	const FQuat room_rotation = settings.m_room_rotation.Quaternion();
+	const float scale = settings.m_room_scale;
+
+	// bodies in a room of 4 x 4 x 4 m, with points fixed to them
+	const int32 num = 200;
+	DTrackPoseArrays poses;
+	random_pose_arrays(n_random, num, poses);
+	poses.loc_x.resize(num);
+	poses.loc_y.resize(num);
+	poses.loc_z.resize(num);
+	for (int32 i = 0; i < num; i++) {
+		poses.loc_x[i] = n_random.FRandRange(-2000.f, 2000.f);
+		poses.loc_y[i] = n_random.FRandRange(-2000.f, 2000.f);
+		poses.loc_z[i] = n_random.FRandRange(-2000.f, 2000.f);
+	}
+	rot2quat(poses);
+
+	TArray<FVector> locations;
+	TArray<FQuat> rotations;
+	Access::from_dtrack_locations<CoordinateSystem, true>(handler, poses, locations);
+	Access::from_dtrack_rotations<CoordinateSystem, true>(handler, poses, rotations);
+
+	double max_location = 0.0;
+	double max_hand_location = 0.0;
+	double max_mirroring = 0.0;
+	double max_rotation = 0.0;
+	double max_rigid = 0.0;
+	double max_scale = 0.0;
+	int32 num_batch_differing = 0;
+
+	for (int32 i = 0; i < num; i++) {
+		const double loc[3] = { poses.loc_x[i], poses.loc_y[i], poses.loc_z[i] };
+		double rot[9];
+		for (int k = 0; k < 9; k++) {
+			rot[k] = poses.rot[k][i];
+		}
+
+		// a point fixed to the body, in body space and in room space (DTrack matrix comes column-wise)
+		const double point[3] = { n_random.FRandRange(-100.f, 100.f), n_random.FRandRange(-100.f, 100.f), n_random.FRandRange(-100.f, 100.f) };
+		double moved[3];
+		for (int r = 0; r < 3; r++) {
+			moved[r] = loc[r] + rot[r] * point[0] + rot[r + 3] * point[1] + rot[r + 6] * point[2];
+		}
+
+		const FVector location = Access::from_dtrack_location<CoordinateSystem, true>(handler, loc);
+		const FQuat rotation = Access::from_dtrack_rotation<CoordinateSystem, true>(handler, rot);
+		const FVector hand_location = Access::from_dtrack_hand_location<CoordinateSystem, true>(handler, point);
+		const FQuat hand_rotation = Access::from_dtrack_hand_rotation<CoordinateSystem, true>(handler, rot);
+
+		const FVector expected_location = room_rotation.RotateVector(mirror_location(
+			Access::from_dtrack_location<CoordinateSystem, false>(handler, loc) * scale, n_mirror_axis)) + settings.m_room_translation;
+		max_location = FMath::Max(max_location, double(FVector::Dist(location, expected_location)));
+
+		const FVector expected_hand_location = mirror_location(
+			Access::from_dtrack_hand_location<CoordinateSystem, false>(handler, point) * scale, n_mirror_axis);
+		max_hand_location = FMath::Max(max_hand_location, double(FVector::Dist(hand_location, expected_hand_location)));
+
+		// mirroring a direction, rotating it and mirroring it back is the mirrored rotation
+		const FQuat unmirrored = Access::from_dtrack_hand_rotation<CoordinateSystem, false>(handler, rot);
+		const FVector direction = n_random.GetUnitVector();
+		const FVector expected_direction = mirror_location(unmirrored.RotateVector(mirror_location(direction, n_mirror_axis)), n_mirror_axis);
+		max_mirroring = FMath::Max(max_mirroring, double(FVector::Dist(hand_rotation.RotateVector(direction), expected_direction)));
+
+		max_rotation = FMath::Max(max_rotation, angle_between(rotation, room_rotation * hand_rotation));
+
+		// the world pose of the body carries the point in body space to its world location
+		const FVector moved_location = Access::from_dtrack_location<CoordinateSystem, true>(handler, moved);
+		max_rigid = FMath::Max(max_rigid, double(FVector::Dist(location + rotation.RotateVector(hand_location), moved_location)));
+
+		// distances in the world are scaled distances in the room (mm to cm)
+		const double room_distance = std::sqrt(point[0] * point[0] + point[1] * point[1] + point[2] * point[2]);
+		max_scale = FMath::Max(max_scale, std::abs(FVector::Dist(location, moved_location) - room_distance * scale / 10.0));
+
+		if (FVector::Dist(locations[i], location) > 1e-4f || angle_between(rotations[i], rotation) > 1e-4) {
+			num_batch_differing++;
+		}
+	}
+
+	// a mirroring flips the handedness, rotation and scale keep it
+	const double det_room = location_determinant<CoordinateSystem, true>(handler);
+	const double det_axes = location_determinant<CoordinateSystem, false>(handler);
+	const bool flipped = (det_room < 0.0) != (det_axes < 0.0);
+
+	n_test.TestTrue(FString::Printf(TEXT("%s: largest location difference: %g cm"), n_name, max_location), max_location < 1e-3);
+	n_test.TestTrue(FString::Printf(TEXT("%s: largest hand location difference: %g cm"), n_name, max_hand_location), max_hand_location < 1e-4);
+	n_test.TestTrue(FString::Printf(TEXT("%s: largest difference to the mirrored rotation: %g"), n_name, max_mirroring), max_mirroring < 1e-5);
+	n_test.TestTrue(FString::Printf(TEXT("%s: largest difference to the room rotation: %g degrees"), n_name, max_rotation), max_rotation < 1e-4);
+	n_test.TestTrue(FString::Printf(TEXT("%s: largest difference of a point moved with its body: %g cm"), n_name, max_rigid), max_rigid < 1e-3);
+	n_test.TestTrue(FString::Printf(TEXT("%s: largest difference of scaled distances: %g cm"), n_name, max_scale), max_scale < 1e-3);
+	n_test.TestTrue(FString::Printf(TEXT("%s: %d poses differing between pose arrays and single poses"), n_name, num_batch_differing), num_batch_differing == 0);
+	n_test.TestTrue(FString::Printf(TEXT("%s: handedness flipped by mirroring only"), n_name), flipped == (n_mirror_axis != EAxis::None));
+	n_test.TestTrue(FString::Printf(TEXT("%s: volume scaled by the cube of the scale"), n_name),
+		FMath::IsNearlyEqual(std::abs(det_room / det_axes), double(scale) * scale * scale, 1e-3));
+}
+
+// Counts the allocations of one thread, passing all calls on to the allocator it wraps
+class FDTrackCountingMalloc : public FMalloc
+{
+public:
+
+	// wraps an allocator and counts the allocations of a thread from now on
+	void wrap(FMalloc* n_inner, uint32 n_thread_id) {
+		m_inner = n_inner;
+		m_thread_id = n_thread_id;
+		m_num_allocations.Reset();
+	}
+
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override {
+		count();
+		return m_inner->Malloc(Count, Alignment);
+	}
+
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override {
+		if (Count != 0) {
+			count();
+		}
+		return m_inner->Realloc(Original, Count, Alignment);
+	}
+
+	virtual void Free(void* Original) override {
+		m_inner->Free(Original);
+	}
+
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override {
+		return m_inner->GetAllocationSize(Original, SizeOut);
+	}
+
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override {
+		return m_inner->QuantizeSize(Count, Alignment);
+	}
+
+	virtual bool IsInternallyThreadSafe() const override {
+		return m_inner->IsInternallyThreadSafe();
+	}
+
+	virtual const TCHAR* GetDescriptiveName() override {
+		return m_inner->GetDescriptiveName();
+	}
+
+	int32 get_num_allocations() const {
+		return m_num_allocations.GetValue();
+	}
+
+private:
+
+	void count() {
+		if (FPlatformTLS::GetCurrentThreadId() == m_thread_id) {
+			m_num_allocations.Increment();
+		}
+	}
+
+	FMalloc* m_inner = nullptr;
+	uint32 m_thread_id = 0;
+	FThreadSafeCounter m_num_allocations;
+};
+
+// Receives the Flysticks of FDTrackSDKHandler instead of pushing them to LiveLink, keeps the states of the last one
+class FDTrackFlystickSink : public FDTrackLiveLinkSource
+{
+public:
+
+	virtual void handle_flystick_data_anythread(double n_worldtime, double n_timestamp, int32 n_source, int32 n_itemId, float n_quality,
+		const FVector& n_location, const FQuat& n_rotation, int32 n_button_count, int32 n_button_mask, int32 n_joystick_count, const float* n_joysticks) override {
+
+		m_num_flysticks++;
+		m_id = n_itemId;
+		m_button_count = n_button_count;
+		m_button_mask = n_button_mask;
+		m_joystick_count = FMath::Min(n_joystick_count, DTRACK_FLYSTICK_MAX_JOYSTICK);
+		FMemory::Memcpy(m_joysticks, n_joysticks, m_joystick_count * sizeof(float));
+	}
+
+	int32 m_num_flysticks = 0;
+	int32 m_id = -1;
+	int32 m_button_count = 0;
+	int32 m_button_mask = 0;
+	int32 m_joystick_count = 0;
+	float m_joysticks[DTRACK_FLYSTICK_MAX_JOYSTICK] = {};
+};
+
+// DTrack packet with Flysticks of 8 buttons and 2 joystick values each, states depend on the frame counter
+std::string flystick_packet(int32 n_frame, int32 n_num_flysticks) {
+
+	FString packet = FString::Printf(TEXT("fr %d\r\n6df2 %d %d"), n_frame, n_num_flysticks, n_num_flysticks);
+	for (int32 i = 0; i < n_num_flysticks; i++) {
+		packet += FString::Printf(TEXT(" [%d 1.000 8 2][%.3f %.3f %.3f][1 0 0 0 1 0 0 0 1][%d %.3f %.3f]"),
+			i, 100.0 * i + n_frame % 100, -200.0, 1500.0, (n_frame + i) % 256, ((n_frame + i) % 21 - 10) / 10.0, (n_frame % 11 - 5) / 5.0);
+	}
+	packet += TEXT("\r\n");
+	return std::string(TCHAR_TO_UTF8(*packet));
+}
+
+}  // namespace
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDTrackRotationConversionTest, "DTrack.SDKHandler.RotationConversion",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDTrackRotationConversionTest::RunTest(const FString& Parameters) {
+
+	// not a multiple of the vector width, so the remainder of the kernel is run as well
+	const int32 num = 1003;
+
+	// rotations about 180 degrees take the other cases of the conversion
+	const double half_turns[][9] = {
+		{  1.0,  0.0,  0.0,   0.0, -1.0,  0.0,   0.0,  0.0, -1.0 },
+		{ -1.0,  0.0,  0.0,   0.0,  1.0,  0.0,   0.0,  0.0, -1.0 },
+		{ -1.0,  0.0,  0.0,   0.0, -1.0,  0.0,   0.0,  0.0,  1.0 },
+		{  0.0,  1.0,  0.0,   1.0,  0.0,  0.0,   0.0,  0.0, -1.0 },
+		{  0.0,  0.0,  1.0,   0.0, -1.0,  0.0,   1.0,  0.0,  0.0 },
+		{ -1.0,  0.0,  0.0,   0.0,  0.0,  1.0,   0.0,  1.0,  0.0 },
+	};
+	const int32 num_half_turns = UE_ARRAY_COUNT(half_turns);
+
+	DTrackPoseArrays poses;
+	poses.num = num;
+	for (int k = 0; k < 9; k++) {
+		poses.rot[k].resize(num);
+	}
+
+	FRandomStream random(2019);
+	for (int32 i = 0; i < num; i++) {
+		double rot[9];
+		if (i % 50 < num_half_turns) {
+			FMemory::Memcpy(rot, half_turns[i % 50], sizeof(rot));
+		}
+		else {
+			random_rotation(random, rot);
+		}
+
+		for (int k = 0; k < 9; k++) {
+			poses.rot[k][i] = rot[k];
+		}
+	}
+
+	rot2quat(poses);
+
+	// the kernel takes the same case as the scalar conversion, so it gives the same bits
+	int32 num_differing = 0;
+	for (int32 i = 0; i < num; i++) {
+		double rot[9];
+		for (int k = 0; k < 9; k++) {
+			rot[k] = poses.rot[k][i];
+		}
+
+		const DTrackQuaternion quat = rot2quat(rot);
+		if (quat.w != poses.quat[0][i] || quat.x != poses.quat[1][i] || quat.y != poses.quat[2][i] || quat.z != poses.quat[3][i]) {
+			num_differing++;
+		}
+	}
+	TestEqual(TEXT("Rotations of pose arrays differing from scalar rot2quat()"), num_differing, 0);
+
+	// both room calibrations, compared to the conversion through FMatrix and FRotator
+	FDTrackSDKHandler handler(nullptr);
+	TArray<FQuat> rotations;
+	const EDTrackCoordinateSystemType coordinate_systems[] = { EDTrackCoordinateSystemType::CST_Normal, EDTrackCoordinateSystemType::CST_Powerwall };
+
+	for (EDTrackCoordinateSystemType coordinate_system : coordinate_systems) {
+		if (coordinate_system == EDTrackCoordinateSystemType::CST_Powerwall) {
+			FDTrackSDKHandlerTestAccess::from_dtrack_rotations<EDTrackCoordinateSystemType::CST_Powerwall>(handler, poses, rotations);
+		}
+		else {
+			FDTrackSDKHandlerTestAccess::from_dtrack_rotations<EDTrackCoordinateSystemType::CST_Normal>(handler, poses, rotations);
+		}
+
+		double max_angle = 0.0;
+		for (int32 i = 0; i < num; i++) {
+			double rot[9];
+			for (int k = 0; k < 9; k++) {
+				rot[k] = poses.rot[k][i];
+			}
+
+			max_angle = FMath::Max(max_angle, angle_between(matrix_path_rotation(coordinate_system, rot), rotations[i]));
+		}
+
+		TestTrue(FString::Printf(TEXT("Largest difference to the FMatrix/FRotator conversion (%s): %g degrees"),
+			coordinate_system == EDTrackCoordinateSystemType::CST_Powerwall ? TEXT("Powerwall") : TEXT("Normal"), max_angle),
+			max_angle < 1e-3);
+	}
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDTrackRotationConversionPerformanceTest, "DTrack.SDKHandler.RotationConversionPerformance",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FDTrackRotationConversionPerformanceTest::RunTest(const FString& Parameters) {
+
+	// about the rotations of a frame of a big setup, converted many times
+	const int32 num = 1024;
+	const int32 num_runs = 1000;
+
+	DTrackPoseArrays poses;
+	FRandomStream random(2019);
+	random_pose_arrays(random, num, poses);
+
+	// quaternions of all pose arrays at once, as used by the handler
+	double start = FPlatformTime::Seconds();
+	for (int32 run = 0; run < num_runs; run++) {
+		rot2quat(poses);
+	}
+	const double time_arrays = FPlatformTime::Seconds() - start;
+
+	// scalar quaternions, one rotation at a time
+	double sum = 0.0;
+	start = FPlatformTime::Seconds();
+	for (int32 run = 0; run < num_runs; run++) {
+		for (int32 i = 0; i < num; i++) {
+			double rot[9];
+			for (int k = 0; k < 9; k++) {
+				rot[k] = poses.rot[k][i];
+			}
+			sum += rot2quat(rot).w;
+		}
+	}
+	const double time_scalar = FPlatformTime::Seconds() - start;
+
+	// Unreal rotations, by the quaternion kernel and by FMatrix and FRotator as before
+	FDTrackSDKHandler handler(nullptr);
+	TArray<FQuat> rotations;
+	start = FPlatformTime::Seconds();
+	for (int32 run = 0; run < num_runs; run++) {
+		FDTrackSDKHandlerTestAccess::from_dtrack_rotations<EDTrackCoordinateSystemType::CST_Normal>(handler, poses, rotations);
+	}
+	const double time_handler = FPlatformTime::Seconds() - start;
+
+	start = FPlatformTime::Seconds();
+	for (int32 run = 0; run < num_runs; run++) {
+		for (int32 i = 0; i < num; i++) {
+			double rot[9];
+			for (int k = 0; k < 9; k++) {
+				rot[k] = poses.rot[k][i];
+			}
+			sum += matrix_path_rotation(EDTrackCoordinateSystemType::CST_Normal, rot).W;
+		}
+	}
+	const double time_matrix = FPlatformTime::Seconds() - start;
+
+	const double num_total = double(num) * num_runs;
+	AddInfo(FString::Printf(TEXT("rot2quat() of pose arrays: %.1f million rotations per second"), num_total / time_arrays * 1e-6));
+	AddInfo(FString::Printf(TEXT("rot2quat() per rotation: %.1f million rotations per second"), num_total / time_scalar * 1e-6));
+	AddInfo(FString::Printf(TEXT("Unreal rotations of pose arrays: %.1f million rotations per second"), num_total / time_handler * 1e-6));
+	AddInfo(FString::Printf(TEXT("Unreal rotations by FMatrix and FRotator: %.1f million rotations per second (checksum %g)"),
+		num_total / time_matrix * 1e-6, sum));
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDTrackRoomTransformTest, "DTrack.SDKHandler.RoomTransform",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDTrackRoomTransformTest::RunTest(const FString& Parameters) {
+
+	const EAxis::Type mirror_axes[] = { EAxis::None, EAxis::X, EAxis::Y, EAxis::Z };
+	const TCHAR* mirror_names[] = { TEXT("None"), TEXT("X"), TEXT("Y"), TEXT("Z") };
+
+	FRandomStream random(2019);
+	for (int k = 0; k < 4; k++) {
+		test_room_transform<EDTrackCoordinateSystemType::CST_Normal>(*this,
+			*FString::Printf(TEXT("Normal, mirror %s"), mirror_names[k]), mirror_axes[k], random);
+		test_room_transform<EDTrackCoordinateSystemType::CST_Powerwall>(*this,
+			*FString::Printf(TEXT("Powerwall, mirror %s"), mirror_names[k]), mirror_axes[k], random);
+	}
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDTrackFlystickAllocationsTest, "DTrack.SDKHandler.FlystickAllocations",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDTrackFlystickAllocationsTest::RunTest(const FString& Parameters) {
+
+	const int32 num_flysticks = 4;
+	const int32 num_warmup_frames = 10;
+	const int32 num_frames = 1000;
+
+	// all packets in advance, so just the handler runs while counting
+	TArray<std::string> packets;
+	for (int32 frame = 0; frame < num_warmup_frames + num_frames; frame++) {
+		packets.Add(flystick_packet(frame, num_flysticks));
+	}
+
+	DTrackSDK dtrack(static_cast<unsigned short>(0));
+	dtrack.setPoseArraysEnabled(true);
+
+	FDTrackFlystickSink sink;
+	FDTrackSDKHandler handler(&sink);
+
+	// storage of the handler grows in the first frames
+	for (int32 frame = 0; frame < num_warmup_frames; frame++) {
+		dtrack.processPacket(packets[frame]);
+		FDTrackSDKHandlerTestAccess::handle_flysticks<EDTrackCoordinateSystemType::CST_Normal, false>(handler, dtrack, 0);
+	}
+
+	// outlives the test, in case another thread is still in a call while the previous allocator is restored
+	static FDTrackCountingMalloc counting_malloc;
+	FMalloc* previous_malloc = GMalloc;
+	counting_malloc.wrap(previous_malloc, FPlatformTLS::GetCurrentThreadId());
+	GMalloc = &counting_malloc;
+
+	int32 num_allocations = 0;
+	int32 num_failed_packets = 0;
+	for (int32 frame = num_warmup_frames; frame < num_warmup_frames + num_frames; frame++) {
+		if (!dtrack.processPacket(packets[frame])) {
+			num_failed_packets++;
+		}
+
+		const int32 num_before = counting_malloc.get_num_allocations();
+		FDTrackSDKHandlerTestAccess::handle_flysticks<EDTrackCoordinateSystemType::CST_Normal, false>(handler, dtrack, 0);
+		num_allocations += counting_malloc.get_num_allocations() - num_before;
+	}
+
+	GMalloc = previous_malloc;
+
+	TestEqual(TEXT("Packets failed to parse"), num_failed_packets, 0);
+	TestEqual(TEXT("Flysticks handled"), sink.m_num_flysticks, (num_warmup_frames + num_frames) * num_flysticks);
+	TestEqual(TEXT("Allocations of handle_flysticks() in steady state"), num_allocations, 0);
+
+	// states of the last Flystick of the last frame
+	const int32 last_frame = num_warmup_frames + num_frames - 1;
+	TestEqual(TEXT("Id of the last Flystick"), sink.m_id, num_flysticks - 1);
+	TestEqual(TEXT("Button count"), sink.m_button_count, 8);
+	TestEqual(TEXT("Button mask"), sink.m_button_mask, (last_frame + num_flysticks - 1) % 256);
+	TestEqual(TEXT("Joystick count"), sink.m_joystick_count, 2);
+	TestEqual(TEXT("Joystick value"), sink.m_joysticks[0], float(((last_frame + num_flysticks - 1) % 21 - 10) / 10.0));
+
+	// Blueprints get the states as arrays, built from the frame data as pushed
+	FLiveLinkSubjectFrameData subject_data;
+	FDTrackFlystickInputStaticData static_data;
+	static_data.m_flystick_id = sink.m_id;
+	static_data.m_button_count = sink.m_button_count;
+	static_data.m_joystick_count = sink.m_joystick_count;
+	subject_data.StaticData.InitializeWith(FDTrackFlystickInputStaticData::StaticStruct(), &static_data);
+
+	FDTrackFlystickInputFrameData frame_data;
+	frame_data.m_button_mask = sink.m_button_mask;
+	FMemory::Memcpy(frame_data.m_joystick_values, sink.m_joysticks, sizeof(sink.m_joysticks));
+	subject_data.FrameData.InitializeWith(FDTrackFlystickInputFrameData::StaticStruct(), &frame_data);
+
+	FLiveLinkBlueprintDataStruct blueprint_data(FDTrackFlystickInputBlueprintData::StaticStruct());
+	TestTrue(TEXT("Blueprint data initialized"), GetDefault<UDTrackFlystickInputRole>()->InitializeBlueprintData(subject_data, blueprint_data));
+
+	const FDTrackFlystickInputFrameData& blueprint_frame = blueprint_data.Cast<FDTrackFlystickInputBlueprintData>()->m_frame_data;
+	if (TestEqual(TEXT("Blueprint button states"), blueprint_frame.m_button_state.Num(), 8)) {
+		for (int32 i = 0; i < 8; i++) {
+			TestTrue(FString::Printf(TEXT("Blueprint button %d"), i), blueprint_frame.m_button_state[i] == (((sink.m_button_mask >> i) & 1) != 0));
+		}
+	}
+	if (TestEqual(TEXT("Blueprint joystick values"), blueprint_frame.m_joystick_state.Num(), 2)) {
+		TestEqual(TEXT("Blueprint joystick 0"), blueprint_frame.m_joystick_state[0], sink.m_joysticks[0]);
+		TestEqual(TEXT("Blueprint joystick 1"), blueprint_frame.m_joystick_state[1], sink.m_joysticks[1]);
+	}
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDTrackFingerPosesTest, "DTrack.SDKHandler.FingerPoses",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDTrackFingerPosesTest::RunTest(const FString& Parameters) {
+
+	const int32 num_hands = 200;
+	const int32 num_fingers = 5;
+
+	TArray<DTrackHand> hands;
+	TArray<FTransform> hand_transforms;
+	TArray<FDTrackFinger> fingers;
+
+	FRandomStream random(2019);
+	random_hands(random, num_hands, num_fingers, hands, hand_transforms, fingers);
+
+	TArray<FDTrackFinger> expected = fingers;
+	compute_finger_joint_poses(hands, hand_transforms, expected);
+
+	// phalanx lengths are given along the X and Z axes of the DTrack finger coordinate system
+	const double dtrack_finger_axis_x[3] = { 1.0, 0.0, 0.0 };
+	const double dtrack_finger_axis_z[3] = { 0.0, 0.0, 1.0 };
+
+	FDTrackSDKHandler handler(nullptr);
+	FDTrackSDKHandlerTestAccess::compute_finger_poses(handler, hands, hand_transforms,
+		finger_space_location(dtrack_finger_axis_x), finger_space_location(dtrack_finger_axis_z), fingers);
+
+	double max_distance = 0.0;
+	double max_angle = 0.0;
+	for (int32 i = 0; i < fingers.Num(); i++) {
+		const FTransform* computed[] = { &fingers[i].m_tip_transform, &fingers[i].m_outer_phalanx_transform,
+			&fingers[i].m_middle_phalanx_transform, &fingers[i].m_inner_phalanx_transform };
+		const FTransform* reference[] = { &expected[i].m_tip_transform, &expected[i].m_outer_phalanx_transform,
+			&expected[i].m_middle_phalanx_transform, &expected[i].m_inner_phalanx_transform };
+
+		for (int k = 0; k < 4; k++) {
+			max_distance = FMath::Max(max_distance, double(FVector::Dist(computed[k]->GetLocation(), reference[k]->GetLocation())));
+			max_angle = FMath::Max(max_angle, angle_between(computed[k]->GetRotation(), reference[k]->GetRotation()));
+		}
+	}
+
+	TestTrue(FString::Printf(TEXT("Largest location difference to the previous computation: %g cm"), max_distance), max_distance < 3e-5);
+	TestTrue(FString::Printf(TEXT("Largest rotation difference to the previous computation: %g degrees"), max_angle), max_angle < 1.3e-4);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDTrackFingerPosesPerformanceTest, "DTrack.SDKHandler.FingerPosesPerformance",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FDTrackFingerPosesPerformanceTest::RunTest(const FString& Parameters) {
+
+	// the hands of a few users, computed for many frames
+	const int32 num_hands = 8;
+	const int32 num_fingers = 5;
+	const int32 num_runs = 20000;
+
+	TArray<DTrackHand> hands;
+	TArray<FTransform> hand_transforms;
+	TArray<FDTrackFinger> hand_space_fingers;
+
+	FRandomStream random(2019);
+	random_hands(random, num_hands, num_fingers, hands, hand_transforms, hand_space_fingers);
+
+	const double dtrack_finger_axis_x[3] = { 1.0, 0.0, 0.0 };
+	const double dtrack_finger_axis_z[3] = { 0.0, 0.0, 1.0 };
+	const FVector finger_axis_x = finger_space_location(dtrack_finger_axis_x);
+	const FVector finger_axis_z = finger_space_location(dtrack_finger_axis_z);
+
+	// both computations start from the fingers in hand space in each run, so both include copying them
+	FDTrackSDKHandler handler(nullptr);
+	TArray<FDTrackFinger> fingers;
+	double start = FPlatformTime::Seconds();
+	for (int32 run = 0; run < num_runs; run++) {
+		fingers = hand_space_fingers;
+		FDTrackSDKHandlerTestAccess::compute_finger_poses(handler, hands, hand_transforms, finger_axis_x, finger_axis_z, fingers);
+	}
+	const double time_quat = FPlatformTime::Seconds() - start;
+
+	TArray<FDTrackFinger> expected;
+	start = FPlatformTime::Seconds();
+	for (int32 run = 0; run < num_runs; run++) {
+		expected = hand_space_fingers;
+		compute_finger_joint_poses(hands, hand_transforms, expected);
+	}
+	const double time_rotator = FPlatformTime::Seconds() - start;
+
+	TestTrue(TEXT("Same finger poses as the previous computation"),
+		FVector::Dist(fingers.Last().m_inner_phalanx_transform.GetLocation(), expected.Last().m_inner_phalanx_transform.GetLocation()) < 3e-5f);
+
+	const double num_total = double(num_hands) * num_fingers * num_runs;
+	AddInfo(FString::Printf(TEXT("compute_finger_poses(): %.1f ns per finger"), time_quat / num_total * 1e9));
+	AddInfo(FString::Printf(TEXT("Previous computation by FRotator: %.1f ns per finger"), time_rotator / num_total * 1e9));
+
+	return true;
+}
+
+#endif
@@ -49,6 +49,24 @@ enum class EDTrackCoordinateSystemType : uint8 {
 };
 
 
+/**
+ * Handling of tracking frames that queued up while the
+ * previous one was processed
+ */
+UENUM(BlueprintType, Category=DTrack)
+enum class EDTrackBacklogPolicy : uint8 {
+
+	/// Process just the newest frame, drop older ones
+	BP_NewestOnly  UMETA(DisplayName = "Newest Only"),
+
+	/// Process every frame, e.g. for recording
+	BP_ProcessAll  UMETA(DisplayName = "Process All"),
+
+	/// Process up to a maximum number of newest frames, drop older ones
+	BP_Bounded     UMETA(DisplayName = "Bounded"),
+};
+
+
 UENUM(BlueprintType)
 enum class EDTrackFingerType : uint8 {
 	FT_Thumb    UMETA(DisplayName = "Thumb"),
@@ -35,6 +35,9 @@
 class FDTrackSDKHandler;
 class ILiveLinkClient;
 
+// Identifies a tracked item: index of the source (0 for the main data port, then additional data ports) and item id
+typedef TPair<int32, int32> FDTrackItemKey;
+
 class DTRACKPLUGIN_API FDTrackLiveLinkSource : public ILiveLinkSource
 {
 public:
@@ -61,18 +64,25 @@ public:
 	virtual void OnSettingsChanged(ULiveLinkSourceSettings* InSettings, const FPropertyChangedEvent& InPropertyChangedEvent) override;
 	//~ End ILiveLinkSource
 
-	void handle_body_data_anythread(double n_worldtime, double n_timestamp, int32 n_itemId, float n_quality, const FVector& n_location, const FRotator& n_rotation);
-	void handle_flystick_data_anythread(double n_worldtime, double n_timestamp, int32 n_itemId, float n_quality, const FVector& n_location, const FRotator& n_rotation, TArray<bool>& n_temp_buttons, TArray<float>& n_temp_joysticks);
+	// receivers of the tracking data of FDTrackSDKHandler, virtual to receive it elsewhere, e.g. in tests
+	virtual void handle_body_data_anythread(double n_worldtime, double n_timestamp, int32 n_source, int32 n_itemId, float n_quality, const FVector& n_location, const FQuat& n_rotation);
+	virtual void handle_flystick_data_anythread(double n_worldtime, double n_timestamp, int32 n_source, int32 n_itemId, float n_quality, const FVector& n_location, const FQuat& n_rotation, int32 n_button_count, int32 n_button_mask, int32 n_joystick_count, const float* n_joysticks);
 
-	void handle_hand_data_anythread(double n_worldtime, double n_timestamp, int32 n_itemId, float n_quality, bool n_is_right_hand, const FTransform& n_transform, TArray<EDTrackFingerType>& n_temp_fingers_type, TArray<FDTrackFinger>& n_temp_fingers);
+	virtual void handle_hand_data_anythread(double n_worldtime, double n_timestamp, int32 n_source, int32 n_itemId, float n_quality, bool n_is_right_hand, const FTransform& n_transform, TArrayView<const EDTrackFingerType> n_fingers_type, TArrayView<const FDTrackFinger> n_fingers);
 
 	TSharedPtr<FDTrackSDKHandler> GetDTrackSDKHandler() { return m_sdk_handler; };
 
 protected:
 
 	void reset_datamaps();
-	void handle_flystick_body_anythread(double n_worldtime, double n_timestamp, int32 n_itemId, float n_quality, const FVector& n_location, const FRotator& n_rotation);
-	void handle_flystick_input_anythread(double n_worldtime, double n_timestamp, int32 n_itemId, TArray<bool>& n_temp_buttons, TArray<float>& n_temp_joysticks);
+
+	// Sets the subject name prefix of each source from the server settings
+	void update_subject_prefixes(const FDTrackServerSettings& n_server_settings);
+
+	// Subject name prefix of a source, needs m_data_access_criticalsection
+	const FString& get_subject_prefix(int32 n_source) const;
+	void handle_flystick_body_anythread(double n_worldtime, double n_timestamp, int32 n_source, int32 n_itemId, float n_quality, const FVector& n_location, const FQuat& n_rotation);
+	void handle_flystick_input_anythread(double n_worldtime, double n_timestamp, int32 n_source, int32 n_itemId, int32 n_button_count, int32 n_button_mask, int32 n_joystick_count, const float* n_joysticks);
 
 	
 private:
@@ -96,13 +106,16 @@ private:
 	mutable FCriticalSection m_data_access_criticalsection;
 
 	// Maps to keep track of subjects that were added and associated static data to know when it changed
-	TMap<int32, FLiveLinkSubjectKey> m_body_subjects;
-	TMap<int32, FLiveLinkSubjectKey> m_flystick_body_subjects;
-	TMap<int32, FLiveLinkSubjectKey> m_flystick_input_subjects;
+	TMap<FDTrackItemKey, FLiveLinkSubjectKey> m_body_subjects;
+	TMap<FDTrackItemKey, FLiveLinkSubjectKey> m_flystick_body_subjects;
+	TMap<FDTrackItemKey, FLiveLinkSubjectKey> m_flystick_input_subjects;
 	TMap<FName, FDTrackFlystickInputStaticData> m_flystick_input_static_data_map;
 
-	TMap<int32, FLiveLinkSubjectKey> m_hand_subjects;
+	TMap<FDTrackItemKey, FLiveLinkSubjectKey> m_hand_subjects;
 	TMap<FName, FDTrackHandStaticData> m_hand_static_data_map;
-	TMap<int32, FLiveLinkSubjectKey> m_human_subjects;
+	TMap<FDTrackItemKey, FLiveLinkSubjectKey> m_human_subjects;
 	TMap<FName, FLiveLinkSkeletonStaticData> m_human_static_data_map;
+
+	// Subject name prefix of each source, the main data port uses 'DTrack'
+	TArray<FString> m_subject_prefixes;
 };
\ No newline at end of file
@@ -34,6 +34,29 @@
 #include "DTrackLiveLinkSourceSettings.generated.h"
 
 
+USTRUCT(BlueprintType)
+struct FDTrackAdditionalSource
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	bool operator==(const FDTrackAdditionalSource& Other) const
+	{
+		return m_dtrack_server_port == Other.m_dtrack_server_port
+			&& m_subject_prefix == Other.m_subject_prefix;
+	}
+
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Server Settings", meta = (DisplayName = "DTrack Data Port", ToolTip = "Port this server sends data to"))
+	int32 m_dtrack_server_port = 5001;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Server Settings", meta = (DisplayName = "Subject Prefix", ToolTip = "Prefix of the LiveLink subject names of this server, instead of 'DTrack'; empty for 'DTrack-<port>'"))
+	FString m_subject_prefix;
+};
+
+
 USTRUCT(BlueprintType)
 struct FDTrackServerSettings
 {
@@ -45,9 +68,25 @@ public:
 	{
 		return m_dtrack_server_ip == Other.m_dtrack_server_ip
 			&& m_dtrack_server_port == Other.m_dtrack_server_port
+			&& m_multicast_ip == Other.m_multicast_ip
 			&& m_dtrack_start_mea == Other.m_dtrack_start_mea
 			&& m_dtrack_tactile_fingers == Other.m_dtrack_tactile_fingers
-			&& m_coordinate_system == Other.m_coordinate_system;
+			&& m_coordinate_system == Other.m_coordinate_system
+			&& m_room_rotation == Other.m_room_rotation
+			&& m_room_translation == Other.m_room_translation
+			&& m_room_scale == Other.m_room_scale
+			&& m_room_mirror_axis == Other.m_room_mirror_axis
+			&& m_backlog_policy == Other.m_backlog_policy
+			&& m_backlog_max_frames == Other.m_backlog_max_frames
+			&& m_low_latency_mode == Other.m_low_latency_mode
+			&& m_receive_buffer_kb == Other.m_receive_buffer_kb
+			&& m_busy_poll_us == Other.m_busy_poll_us
+			&& m_spin_wait_us == Other.m_spin_wait_us
+			&& m_additional_sources == Other.m_additional_sources
+			&& m_receive_bodies == Other.m_receive_bodies
+			&& m_receive_flysticks == Other.m_receive_flysticks
+			&& m_receive_hands == Other.m_receive_hands
+			&& m_body_ids == Other.m_body_ids;
 	}
 
 	bool operator!=(const FDTrackServerSettings& Other) const
@@ -60,6 +99,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Server Settings", meta = (DisplayName = "DTrack Data Port", ToolTip = "Port your server sends data to"))
 	int32 m_dtrack_server_port = 5000;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Server Settings", meta = (DisplayName = "Multicast IP", ToolTip = "Multicast group your server sends data to, empty for unicast; several instances on one host can share it"))
+	FString m_multicast_ip;
+
 	//UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Server Settings", meta = (DisplayName = "Start DTrack Measurement", ToolTip = "Start measurement via the DTrack2 TCP command channel"))
 	bool m_dtrack_start_mea = false;
 	
@@ -71,6 +113,51 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Server Settings", meta = (DisplayName = "DTrack Room Calibration Type", ToolTip = "Set this according to your DTrack system's room calibration type"))
 	EDTrackCoordinateSystemType m_coordinate_system = EDTrackCoordinateSystemType::CST_Normal;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Transform", meta = (DisplayName = "Rotation", ToolTip = "Rotation of the DTrack room in the world, applied on the receive thread to all bodies, Flysticks and hands"))
+	FRotator m_room_rotation = FRotator::ZeroRotator;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Transform", meta = (DisplayName = "Translation (cm)", ToolTip = "Location of the DTrack room origin in the world"))
+	FVector m_room_translation = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Transform", meta = (DisplayName = "Uniform Scale", ToolTip = "Scale of the DTrack room in the world, also applied to hand and finger joint locations; tip radius and phalanx lengths stay in mm as sent by DTrack", ClampMin = "0.001"))
+	float m_room_scale = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Transform", meta = (DisplayName = "Mirror Axis", ToolTip = "Unreal axis to mirror the DTrack room along before rotating, None to keep it"))
+	TEnumAsByte<EAxis::Type> m_room_mirror_axis = EAxis::None;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Server Settings", meta = (DisplayName = "Frame Backlog Policy", ToolTip = "Handling of tracking frames that queued up, e.g. while the game thread hitches"))
+	EDTrackBacklogPolicy m_backlog_policy = EDTrackBacklogPolicy::BP_NewestOnly;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Server Settings", meta = (DisplayName = "Maximum Backlog Frames", ToolTip = "Maximum number of queued frames that are processed", ClampMin = "1", EditCondition = "m_backlog_policy == EDTrackBacklogPolicy::BP_Bounded"))
+	int32 m_backlog_max_frames = 4;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Server Settings", meta = (DisplayName = "Low Latency Mode", ToolTip = "Tune the data socket for low latency; the CPU cost and wake-up latency are logged when tracking stops"))
+	bool m_low_latency_mode = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Server Settings", meta = (DisplayName = "Receive Buffer (KB)", ToolTip = "Size of the socket receive buffer, 0 to keep the system default", ClampMin = "0", EditCondition = "m_low_latency_mode"))
+	int32 m_receive_buffer_kb = 1024;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Server Settings", meta = (DisplayName = "Busy Poll (us)", ToolTip = "Busy polling of the network device while waiting for data (Linux only, might need privileges), 0 to disable", ClampMin = "0", EditCondition = "m_low_latency_mode"))
+	int32 m_busy_poll_us = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Server Settings", meta = (DisplayName = "Spin Before Blocking (us)", ToolTip = "Time to check for data without sleeping before blocking; costs CPU time, saves wake-up latency", ClampMin = "0", EditCondition = "m_low_latency_mode"))
+	int32 m_spin_wait_us = 200;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Server Settings", meta = (DisplayName = "Additional Data Ports", ToolTip = "Further DTrack servers (e.g. a second controller) received by the same thread, each with its own data port and subject prefix"))
+	TArray<FDTrackAdditionalSource> m_additional_sources;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data Filter", meta = (DisplayName = "Receive Bodies", ToolTip = "Parse standard bodies; disable if this instance does not need them"))
+	bool m_receive_bodies = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data Filter", meta = (DisplayName = "Receive Flysticks", ToolTip = "Parse Flysticks; disable if this instance does not need them"))
+	bool m_receive_flysticks = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data Filter", meta = (DisplayName = "Receive Hands", ToolTip = "Parse Fingertracking hands; disable if this instance does not need them"))
+	bool m_receive_hands = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data Filter", meta = (DisplayName = "Body IDs", ToolTip = "Standard bodies parsed by this instance (numbers as in the subject names), empty for all; others are skipped before parsing", EditCondition = "m_receive_bodies"))
+	TArray<int32> m_body_ids;
 };
 
 UCLASS()
@@ -34,6 +34,9 @@
 #include "DTrackLiveLinkTypes.generated.h"
 
 
+/// Maximum number of Flystick joystick values, same as in the DTrack SDK
+#define DTRACK_FLYSTICK_MAX_JOYSTICK  8
+
 
 /**
  * Static data for inputs of flystick tracking data.
@@ -66,11 +69,26 @@ struct DTRACKPLUGIN_API FDTrackFlystickInputFrameData : public FLiveLinkBaseFram
 
 public:
 
+	FDTrackFlystickInputFrameData()
+	{
+		FMemory::Memzero(m_joystick_values);
+	}
+
+	// button states, one entry per button; built from m_button_mask for Blueprints, empty in pushed frames
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flystick")
 	TArray<bool> m_button_state;
 
+	// joystick values (-1 to 1), one entry per joystick axis; built from m_joystick_values for Blueprints, empty in pushed frames
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flystick")
 	TArray<float> m_joystick_state;
+
+	// button states of pushed frames, bit i is set while button i is pressed
+	UPROPERTY()
+	int32 m_button_mask = 0;
+
+	// joystick values of pushed frames, the first m_joystick_count of the static data are valid; fixed size to avoid allocations per frame
+	UPROPERTY()
+	float m_joystick_values[DTRACK_FLYSTICK_MAX_JOYSTICK];
 };
 
 /**
@@ -54,6 +54,8 @@
  * - DTrackDataTypes class provides type definitions
  * - DTrackNet class provides basic UDP/TCP functionality
  * - DTrackParser class provides string parsing
+ * - DTrackFrameBuffer class provides the latest frame to other threads
+ * - DTrackReactor class receives tracking data of several sources in one thread
  */
 
 #ifndef _ART_DTRACKSDK_HPP_
@@ -92,9 +94,17 @@ public:
 		ERR_NONE = 0,  //!< No error
 		ERR_TIMEOUT,   //!< Timeout occured
 		ERR_NET,       //!< Network error
-		ERR_PARSE      //!< Error while parsing command
+		ERR_PARSE,     //!< Error while parsing command
+		ERR_INTERRUPTED  //!< Waiting for data was interrupted
 	} Errors;
 
+	//! Handling of tracking data packets, that queued up between two calls of receive()
+	typedef enum {
+		BACKLOG_NEWEST_ONLY = 0,  //!< Process just the newest packet, drop older ones (default)
+		BACKLOG_PROCESS_ALL,      //!< Process all packets, one per call of receive()
+		BACKLOG_BOUNDED           //!< Process up to a maximum number of newest packets, drop older ones
+	} BacklogPolicy;
+
 	/**
 	 * \brief Universal constructor. Can be used for any mode. Recommended for new applications.
 	 *
@@ -152,7 +162,7 @@ public:
 	 * @param[in] server_port     Port number (UDP) of DTrack1 PC to send commands to (0 if not used)
 	 * @param[in] data_port       Port number (UDP) to receive tracking data from DTrack (0 if to be chosen)
 	 * @param[in] remote_type     Type of system to connect to
-	 * @param[in] data_bufsize    Buffer size for receiving tracking data in bytes; 0 to set default (32768) 
+	 * @param[in] data_bufsize    Initial buffer size for receiving tracking data in bytes; 0 to set default (see setDataBufferSize())
 	 * @param[in] data_timeout_us Timeout for receiving tracking data in us; 0 to set default (1.0 s)
 	 * @param[in] srv_timeout_us  Timeout for reply of Controller in us; 0 to set default (10.0 s)
 	 */
@@ -258,22 +268,211 @@ public:
 	/**
 	 * \brief Set UDP buffer size for receiving tracking data.
 	 *
-	 * @param[in] bufSize Buffer size for receiving tracking data in bytes; 0 to set default (32768)
+	 * The buffer grows automatically, if a packet does not fit (see setDataBufferSizeLimit()).
+	 *
+	 * @param[in] bufSize Buffer size for receiving tracking data in bytes; 0 to set default (8192 on Linux,
+	 *                    where the buffer grows to the size of a bigger packet at once, otherwise 32768)
 	 * @return            Success? (i.e. valid size)
 	 */
 	bool setDataBufferSize( int bufSize );
 
+	/**
+	 * \brief Set limit for automatic growing of the UDP buffer.
+	 *
+	 * A packet, that does not fit into the buffer, is lost; the buffer is enlarged (at least doubled)
+	 * to fit the following ones, but not beyond this limit.
+	 *
+	 * @param[in] maxSize Maximum buffer size in bytes; 0 to set default (65536, fits any UDP packet)
+	 */
+	void setDataBufferSizeLimit( int maxSize );
+
+	/**
+	 * \brief Get current UDP buffer size for receiving tracking data.
+	 *
+	 * @return Buffer size in bytes
+	 */
+	int getDataBufferSize() const;
+
+	/**
+	 * \brief Get size of the biggest tracking data packet received so far (high-water mark).
+	 *
+	 * @return Size in bytes
+	 */
+	int getMaxPacketSize() const;
+
+	/**
+	 * \brief Get number of tracking data packets, that were lost as they did not fit into the UDP buffer.
+	 *
+	 * @return Number of packets
+	 */
+	unsigned int getNumTruncatedPackets() const;
+
+
+	/**
+	 * \brief Set handling of tracking data packets, that queued up between two calls of receive().
+	 *
+	 * @param[in] policy     Backlog policy
+	 * @param[in] maxPackets Maximum number of queued packets to be processed (just for BACKLOG_BOUNDED)
+	 * @return               Success? (i.e. valid maximum number)
+	 */
+	bool setBacklogPolicy( BacklogPolicy policy, int maxPackets = 0 );
+
+	/**
+	 * \brief Get handling of tracking data packets, that queued up between two calls of receive().
+	 *
+	 * @return Backlog policy
+	 */
+	BacklogPolicy getBacklogPolicy() const;
+
+	/**
+	 * \brief Get number of tracking data packets, that were dropped due to the backlog policy.
+	 *
+	 * Counts since creation (or last call of resetNumDroppedPackets()).
+	 *
+	 * @return Number of dropped packets
+	 */
+	unsigned int getNumDroppedPackets() const;
+
+	/**
+	 * \brief Reset number of dropped tracking data packets.
+	 */
+	void resetNumDroppedPackets();
+
+	/**
+	 * \brief Get number of received tracking data packets.
+	 *
+	 * @return Number of packets, including dropped ones
+	 */
+	unsigned int getNumReceivedPackets() const;
+
+	/**
+	 * \brief Get number of system calls needed to receive tracking data packets.
+	 *
+	 * On Linux several packets are received per system call.
+	 *
+	 * @return Number of system calls
+	 */
+	unsigned int getNumReceiveSyscalls() const;
+
+	/**
+	 * \brief Interrupt waiting for tracking data.
+	 *
+	 * Wakes up a receive(), that is waiting in another thread, without waiting for the timeout.
+	 * This and all following calls of receive() fail with ERR_INTERRUPTED. Can be called from any thread.
+	 */
+	void interruptReceive();
+
+	/**
+	 * \brief Allow receiving tracking data again, after interruptReceive().
+	 *
+	 * Keeps the data socket, so a receiving thread can be stopped and started again without opening
+	 * the data port anew. Tracking data, that was received meanwhile (queued in the socket or in the
+	 * backlog), is discarded. Must not be called while another thread is receiving.
+	 */
+	void resumeReceive();
+
+	/**
+	 * \brief Get arrival time of the latest tracking data packet.
+	 *
+	 * Taken by the kernel when the packet arrived, if supported (Linux), so it does not include
+	 * waiting in the backlog and parsing. Otherwise taken when the packet was fetched from the socket.
+	 *
+	 * @return Arrival time in s since 1970-01-01 (UTC); 0 if not available
+	 */
+	double getReceiveTimestamp() const;
+
+	/**
+	 * \brief Get time passed since the latest tracking data packet arrived.
+	 *
+	 * Can be used to convert getReceiveTimestamp() to another clock.
+	 *
+	 * @return Time in s; 0 if not available
+	 */
+	double getReceiveAge() const;
+
+	/**
+	 * \brief Returns if arrival times of tracking data packets are taken by the kernel.
+	 *
+	 * @return Kernel timestamps enabled?
+	 */
+	bool isKernelTimestamp() const;
+
+	/**
+	 * \brief Set size of receive buffer for tracking data.
+	 *
+	 * A bigger buffer avoids losing packets on busy hosts.
+	 *
+	 * @param[in] bytes Requested size in bytes
+	 * @return          Actual size in bytes (might differ, depending on the OS), <0 if error occured
+	 */
+	int setReceiveBufferSize( int bytes );
+
+	/**
+	 * \brief Set busy polling of the network device while waiting for tracking data (Linux only).
+	 *
+	 * @param[in] us Busy polling time in us (micro seconds), 0 to disable
+	 * @return       Setting succeeded?
+	 */
+	bool setBusyPoll( int us );
+
+	/**
+	 * \brief Set time to spin before blocking, while waiting for tracking data.
+	 *
+	 * Spinning saves the wake-up latency of the OS at the cost of CPU time; see getWaitStatistics().
+	 *
+	 * @param[in] us Spinning time in us (micro seconds), 0 to block at once (default)
+	 */
+	void setSpinWait( int us );
+
+	/**
+	 * \brief Get statistics of waiting for tracking data.
+	 *
+	 * Contains the CPU time spent spinning and the measured wake-up latency.
+	 *
+	 * @return Statistics
+	 */
+	DTrackNet::WaitStatistics getWaitStatistics() const;
+
+	/**
+	 * \brief Reset statistics of waiting for tracking data.
+	 */
+	void resetWaitStatistics();
+
+	/**
+	 * \brief Reset all statistics of receiving tracking data.
+	 *
+	 * Resets numbers of received, dropped and lost packets, the maximum packet size, the statistics of
+	 * waiting (see resetWaitStatistics()) and the line counters (see resetLineCounters()).
+	 */
+	void resetStatistics();
 
 	/**
 	 * \brief Receive and process one tracking data packet.
 	 *
 	 * This method waits until a data packet becomes available, but no longer
-	 * than the timeout. Updates internal data structures.
+	 * than the timeout. Updates internal data structures. Packets queued up since
+	 * the last call are handled according to the backlog policy (see setBacklogPolicy()).
 	 *
 	 * @return Receive succeeded?
 	 */
 	bool receive();
 
+	/**
+	 * \brief Receive and process one tracking data packet, if available, without waiting.
+	 *
+	 * Used after waiting for several DTrackSDK instances at once (see DTrackReactor).
+	 *
+	 * @return Receive succeeded? (fails with ERR_TIMEOUT, if no packet is available)
+	 */
+	bool receiveAvailable();
+
+	/**
+	 * \brief Returns if tracking data packets are already fetched from the socket, but not yet processed.
+	 *
+	 * @return Packets pending?
+	 */
+	bool hasPendingData() const;
+
 	/**
 	 * \brief Process one tracking packet manually.
 	 *
@@ -284,6 +483,18 @@ public:
 	 */
 	bool processPacket( const std::string& data );
 
+	/**
+	 * \brief Process one tracking packet manually, without copying it.
+	 *
+	 * This requires no connection to a Controller. Updates internal data structures.
+	 * The data is only read, it has to stay valid during the call only.
+	 *
+	 * @param[in] data Data packet to be processed (needs no terminating '\0')
+	 * @param[in] len  Length of data packet in bytes
+	 * @return         Processing succeeded?
+	 */
+	bool processPacket( const char* data, size_t len );
+
 	/**
 	 * \brief Get content of the UDP buffer.
 	 * 
@@ -291,6 +502,16 @@ public:
 	 */
 	std::string getBuf() const;
 
+	/**
+	 * \brief Get content of the UDP buffer, without copying it.
+	 *
+	 * Valid until the next call of receive().
+	 *
+	 * @param[out] len Length of content in bytes
+	 * @return         Begin of content (terminated by '\0'), NULL if there is no buffer
+	 */
+	const char* getBufView( size_t& len ) const;
+
 
 	/**
 	 * \brief Get last error at receiving tracking data (data transmission).
@@ -528,12 +749,16 @@ public:
 
 private:
 
+	friend class DTrackReactor;  // waits for data socket of several instances
+
 	static const unsigned short DTRACK2_PORT_COMMAND = 50105;  //!< Controller port number (TCP) for 'dtrack2' commands
 	static const unsigned short DTRACK2_PORT_FEEDBACK = 50110;  //!< Controller port number (UDP) for feedback commands
 
 	static const int DEFAULT_TCP_TIMEOUT = 10000000;  //!< default TCP timeout (in us)
 	static const int DEFAULT_UDP_TIMEOUT = 1000000;   //!< default UDP timeout (in us)
-	static const int DEFAULT_UDP_BUFSIZE = 32768;     //!< default UDP buffer size (in bytes)
+	static const int DEFAULT_UDP_BUFSIZE = 32768;     //!< default initial UDP buffer size (in bytes)
+	static const int DEFAULT_UDP_BUFSIZE_TRUNC = 8192; //!< default initial UDP buffer size, if size of truncated packets is known (in bytes)
+	static const int DEFAULT_UDP_BUFSIZE_MAX = 65536; //!< default limit of growing UDP buffer (in bytes)
 
 	/**
 	 * \brief Set last DTrack2/DTrack3 command error.
@@ -554,6 +779,35 @@ private:
 	void init( const std::string& server_host, unsigned short server_port, unsigned short data_port,
 	           RemoteSystemType remote_type );
 
+	/**
+	 * \brief Receive and process one tracking data packet, waiting no longer than the given timeout.
+	 *
+	 * @param[in] toutUs Timeout in us (micro seconds); 0 to not wait
+	 * @return           Receive succeeded?
+	 */
+	bool receiveData( int toutUs );
+
+	/**
+	 * \brief Receive one UDP packet, keeping a bounded number of queued packets (BACKLOG_BOUNDED).
+	 *
+	 * @param[in] toutUs Timeout in us (micro seconds), if no packet is queued
+	 * @return           Number of received bytes, <0 if error/timeout occured (see DTrackNet::UDP::receiveNext())
+	 */
+	int receiveBounded( int toutUs );
+
+	/**
+	 * \brief Enlarge UDP buffer after a packet did not fit.
+	 *
+	 * @param[in] packetSize Size of the packet in bytes, 0 if unknown
+	 * @return               Buffer was enlarged?
+	 */
+	bool growDataBuffer( int packetSize );
+
+	/**
+	 * \brief (Re-)creates the buffers for queued packets.
+	 */
+	void resizeBacklog();
+
 	/**
 	 * \brief Send feedback command via UDP.
 	 *
@@ -579,6 +833,20 @@ private:
 
 	int d_udpbufsize;                   //!< size of UDP buffer
 	char* d_udpbuf;                     //!< UDP buffer
+	size_t d_udplen;                    //!< length of content of UDP buffer
+	int d_udpbufsize_max;               //!< limit of growing UDP buffer
+	int d_udp_maxpacket;                //!< size of biggest received packet (high-water mark)
+	unsigned int d_udp_truncated;       //!< number of packets, that did not fit into UDP buffer
+
+	BacklogPolicy d_backlog_policy;     //!< handling of queued packets
+	int d_backlog_max;                  //!< maximum number of queued packets (BACKLOG_BOUNDED)
+	std::vector< char* > d_backlog_buf; //!< buffers of queued packets, one more than maximum (BACKLOG_BOUNDED)
+	std::vector< int > d_backlog_len;   //!< lengths of queued packets
+	std::vector< double > d_backlog_time; //!< arrival times of queued packets
+	int d_backlog_first;                //!< index of oldest queued packet
+	int d_backlog_num;                  //!< number of queued packets
+	unsigned int d_backlog_dropped;     //!< number of dropped packets
+	double d_receive_timestamp;         //!< arrival time of latest processed packet
 
 	std::string d_message_origin;       //!< last DTrack2 message: origin of message
 	std::string d_message_status;       //!< last DTrack2 message: status of message
@@ -35,6 +35,8 @@
 
 #include "HAL/Runnable.h"
 #include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/CriticalSection.h"
 
 #include "DTrackLiveLinkSourceSettings.h"
 
@@ -46,6 +48,11 @@ class FDTrackLiveLinkSource;
  */
 class DTRACKPLUGIN_API FDTrackSDKHandler : public FRunnable
 {
+#if WITH_DEV_AUTOMATION_TESTS
+	// automation tests of the conversions and finger poses, see Tests/DTrackSDKHandlerTests.cpp
+	friend struct FDTrackSDKHandlerTestAccess;
+#endif
+
 public:
 
 	FDTrackSDKHandler(FDTrackLiveLinkSource* n_livelink_source);
@@ -67,6 +74,16 @@ public:
 	// Gets the status of the sdk to see if an error is present
 	FString get_status() const;
 
+	// Returns the newest complete frame of tracking data, nullptr if none. Lock-free, can be called from any thread.
+	// The frame stays valid until given back by release_frame()
+	const DTrackFrame* acquire_latest_frame();
+
+	// Gives back a frame returned by acquire_latest_frame()
+	void release_frame(const DTrackFrame* n_frame);
+
+	// Returns the number of tracking frames dropped due to the backlog policy since listening started
+	uint32 get_num_dropped_frames() const;
+
 
 public:
 	//~ Begin FRunnable interface
@@ -77,26 +94,67 @@ public:
 
 protected:
 
+	/// Returns true if the SDK instances of the previous run can be kept for the given settings, i.e. no network settings changed
+	bool can_keep_sdk(const FDTrackServerSettings& n_settings) const;
+
+	/// Applies the server settings (backlog policy, socket tuning, parsed lines) to one SDK instance
+	void configure_sdk(DTrackSDK& n_dtrack, const FDTrackServerSettings& n_settings);
+
+	/// Receives the main and all additional data ports in this thread, until stopped
+	void receive_all_sources(const FDTrackServerSettings& n_settings);
+
+	/// after receive, send the frame of one source (0 for the main data port) to listeners
+	void process_frame(DTrackSDK& n_dtrack, int32 n_source);
+
 	/// Each time we received data, we update the time for this frame. Either using the timestamp or the current time.
-	void update_frametime();
+	void update_frametime(DTrackSDK& n_dtrack);
+
+	/// chooses the handle_frame() instantiation and precomposes the room transform for the given settings
+	template<EDTrackCoordinateSystemType CoordinateSystem>
+	void select_frame_handling(const FDTrackServerSettings& n_settings);
+
+	/// treat all tracking info of one frame and send it to listeners, for one room calibration with or without room transform
+	template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+	void handle_frame(DTrackSDK& n_dtrack, int32 n_source);
 
 	/// after receive, treat body info and send it to listeners
-	void handle_bodies();
+	template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+	void handle_bodies(DTrackSDK& n_dtrack, int32 n_source);
 
 	/// after receive, treat flystick info and send it to listeners
-	void handle_flysticks();
+	template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+	void handle_flysticks(DTrackSDK& n_dtrack, int32 n_source);
 
 	/// treat hand tracking info and send it to listeners
-	void handle_hands();
+	template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+	void handle_hands(DTrackSDK& n_dtrack, int32 n_source);
 
-	/// translate dtrack rotation matrix to rotator according to selected room calibration
-	FRotator from_dtrack_rotation(const double(&n_matrix)[9]);
+	/// translate dtrack rotation matrix to quaternion in world space
+	template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+	FQuat from_dtrack_rotation(const double(&n_matrix)[9]) const;
+
+	/// translate dtrack rotations of several bodies to world space (first n_poses.num entries of out_rotations)
+	template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+	void from_dtrack_rotations(const DTrackPoseArrays& n_poses, TArray<FQuat>& out_rotations) const;
 	
-	/// translate dtrack translation to unreal space
-	FVector from_dtrack_location(const double(&n_translation)[3]);
+	/// translate dtrack translation to world space
+	template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+	FVector from_dtrack_location(const double(&n_translation)[3]) const;
+
+	/// translate dtrack translations of several bodies to world space (first n_poses.num entries of out_locations)
+	template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+	void from_dtrack_locations(const DTrackPoseArrays& n_poses, TArray<FVector>& out_locations) const;
 
-	/// Compute each joint pose in world space from its raw information
-	void compute_finger_joint_pose(const FTransform& n_hand_transform, FDTrackFinger& out_finger, const float finger_x_rotation, const float finger_y_rotation, const float finger_z_rotation);
+	/// translate dtrack rotation matrix in hand or finger space to unreal space (no room rotation)
+	template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+	FQuat from_dtrack_hand_rotation(const double(&n_matrix)[9]) const;
+
+	/// translate dtrack translation in hand or finger space to unreal space (no room rotation and translation)
+	template<EDTrackCoordinateSystemType CoordinateSystem, bool RoomTransform>
+	FVector from_dtrack_hand_location(const double(&n_translation)[3]) const;
+
+	/// Compute each joint pose in world space for all fingers of m_hand_poses, from the finger axes (DTrack mm to Unreal cm)
+	void compute_finger_poses(const FVector& n_finger_axis_x, const FVector& n_finger_axis_z);
 
 	/// Return name for finger index
 	FString fingerName( int i );
@@ -114,22 +172,60 @@ private:
 
 	// Current ART server settings
 	FDTrackServerSettings m_server_settings;
+
+	// handle_frame() instantiation for the room calibration and room transform of the current server settings, chosen in start_listening()
+	void (FDTrackSDKHandler::*m_handle_frame)(DTrackSDK& n_dtrack, int32 n_source);
+
+	// Room transform of the current server settings, precomposed with the axis mapping of the room calibration
+	struct FRoomTransform
+	{
+		// DTrack location (mm) to world location (cm) without translation, row major
+		double m_location[9];
+
+		// world location of the DTrack room origin (cm)
+		FVector m_translation;
+
+		// factors for hand space locations after axis mapping, i.e. mirroring and scale
+		double m_hand_scale[3];
+
+		// signs for quaternion axes after axis mapping, i.e. mirroring
+		double m_rotation_signs[3];
+
+		// rotation of the DTrack room in the world
+		FQuat m_rotation;
+	};
+	FRoomTransform m_room_transform;
 	
 	// SDK pointer to access received data
 	TUniquePtr<DTrackSDK> m_dtrack;
 
+	// SDK pointers of additional data ports, received by the same thread
+	TArray<TUniquePtr<DTrackSDK>> m_dtrack_additional;
+
+	// Server settings the current SDK instances were created with
+	FDTrackServerSettings m_sdk_settings;
+
+	// Guards creation and destruction of m_dtrack and m_dtrack_additional against Stop() from other threads
+	FCriticalSection m_dtrack_lock;
+
 	// LiveLink Source that owns us
 	FDTrackLiveLinkSource* m_livelink_source;
 
 	// Thread safe bool for stopping the thread
 	FThreadSafeBool m_is_active;
 
+	// Flag set by Stop() and cleared by start_listening(), so a Stop() during initialization of the thread is not lost
+	FThreadSafeBool m_stop_requested;
+
 	// Flag set when measurement was started for dtrack2
 	FThreadSafeBool m_is_measuring;
 
 	// Flag set during dtrack sdk connection
 	FThreadSafeBool m_is_connecting;
 
+	// Number of tracking frames dropped due to the backlog policy
+	FThreadSafeCounter m_num_dropped_frames;
+
 	// Thread where we poll the sdk for new frames
 	TUniquePtr<FRunnableThread> m_thread;
 
@@ -139,20 +235,48 @@ private:
 	// Timestamp if available for the frame. -1.0 if not available
 	double m_frame_timestamp_seconds;
 
+	// Converted locations and rotations of the bodies or flysticks of the current frame, kept to avoid allocations
+	TArray<FVector> m_pose_locations;
+	TArray<FQuat> m_pose_rotations;
+
+	// Hand of the current frame with its world transform (without skeleton adjustment) and its fingers in m_fingers
+	struct FHandPose
+	{
+		const DTrackHand* m_hand;
+		FTransform m_transform;
+		int32 m_first_finger;
+	};
+
+	// Hands and fingers of all hands of the current frame, kept to avoid allocations
+	TArray<FHandPose> m_hand_poses;
+	TArray<FDTrackFinger> m_fingers;
+
+	// Latest frames of tracking data for readers on other threads, outlives the SDK
+	DTrackFrameBuffer m_frame_buffer;
+
 private:
 
 	/// Number of seconds per day for timestamp adjustments
 	static const int32 m_seconds_per_day;
 
-	/// room coordinate adoption matrix for "normal" setting
-	static const FMatrix  m_trafo_normal;
+	/// Timeout for waiting for data of several data ports (in us)
+	static const int32 m_reactor_timeout_us = 1000000;
+
+	/// Delay before waiting again after a failed wait for data of several data ports (in us)
+	static const int32 m_reactor_error_delay_us = 100000;
+
+	/// rotation appended to left hands, to fit Unreal hand skeletons
+	static const FQuat m_left_hand_adjustment;
+
+	/// rotation appended to right hands, to fit Unreal hand skeletons (including mirroring)
+	static const FQuat m_right_hand_adjustment;
 
-	/// transposed variant cached
-	static const FMatrix  m_trafo_normal_transposed;
+	/// rotation appended to the phalanxes of left hands, to fit Unreal hand skeletons
+	static const FQuat m_left_finger_adjustment;
 
-	/// room coordinate adoption matrix for "power wall" setting
-	static const FMatrix  m_trafo_powerwall;
+	/// rotation appended to the phalanxes of right hands, to fit Unreal hand skeletons
+	static const FQuat m_right_finger_adjustment;
 
-	/// transposed variant cached
-	static const FMatrix  m_trafo_powerwall_transposed;
+	/// finger types in DTrack finger order
+	static const EDTrackFingerType m_finger_types[DTRACKSDK_HAND_MAX_FINGER];
 };